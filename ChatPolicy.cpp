@@ -0,0 +1,67 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ChatPolicy.h"
+
+ChatPolicy::ChatPolicy ()
+{
+    build(true, false);
+}
+
+void ChatPolicy::build (bool allowLimitedChat, bool matchInProgress)
+{
+    for (int senderObserver = 0; senderObserver < 2; senderObserver++)
+    {
+        for (int target = 0; target < LAST_CHAT_TARGET; target++)
+        {
+            for (int recipientObserver = 0; recipientObserver < 2; recipientObserver++)
+            {
+                table[senderObserver][target][recipientObserver] = decide(allowLimitedChat, matchInProgress, senderObserver, (ChatTarget)target, recipientObserver);
+            }
+        }
+    }
+}
+
+bool ChatPolicy::allows (bz_eTeamType senderTeam, bz_eTeamType target, bz_eTeamType recipientTeam) const
+{
+    ChatTarget chatTarget = (target == eObservers) ? TARGET_OBSERVERS : (target == eAdministrators) ? TARGET_ADMINISTRATORS : TARGET_OTHER;
+
+    return table[senderTeam == eObservers][chatTarget][recipientTeam == eObservers];
+}
+
+// The chat policy itself; this is only evaluated when the table is built
+bool ChatPolicy::decide (bool allowLimitedChat, bool matchInProgress, bool senderObserver, ChatTarget target, bool recipientObserver)
+{
+    // Non-league members are not allowed limited talk functionality
+    if (!allowLimitedChat)
+    {
+        return false;
+    }
+
+    // When a match isn't in progress, non-league members may only talk to the admins
+    if (!matchInProgress)
+    {
+        return (target == TARGET_ADMINISTRATORS);
+    }
+
+    // During a match, non-league members in the observer team may talk to the observer team chat or private message a
+    // player in the observer team. This precaution is so they do not private message players participating in a match,
+    // do not message an admin who may be playing a match, and do not send messages to public chat to avoid match
+    // disturbances.
+    return senderObserver && (target == TARGET_OBSERVERS || recipientObserver);
+}
\ No newline at end of file
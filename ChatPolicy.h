@@ -0,0 +1,51 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CHAT_POLICY_H__
+#define __CHAT_POLICY_H__
+
+#include "bzfsAPI.h"
+
+// Who non-league members are allowed to talk to, compiled into a table. The parts of the policy that rarely change
+// (the ALLOW_LIMITED_CHAT option and whether a match is in progress) are folded in by build(), which is called when
+// the configuration is loaded and when the state of a match changes. Deciding on a chat message is then a single
+// lookup indexed by the teams involved in that message.
+class ChatPolicy
+{
+    public:
+        ChatPolicy ();
+
+        void build   (bool allowLimitedChat, bool matchInProgress);
+        bool allows  (bz_eTeamType senderTeam, bz_eTeamType target, bz_eTeamType recipientTeam) const;
+
+    private:
+        enum ChatTarget
+        {
+            TARGET_OBSERVERS,
+            TARGET_ADMINISTRATORS,
+            TARGET_OTHER,
+            LAST_CHAT_TARGET
+        };
+
+        // [sender is an observer][target][recipient is an observer]
+        bool table[2][LAST_CHAT_TARGET][2];
+
+        static bool decide (bool allowLimitedChat, bool matchInProgress, bool senderObserver, ChatTarget target, bool recipientObserver);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,233 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fstream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "ConfigWatcher.h"
+
+// The number of milliseconds without any writes before a change is reported
+static const int QUIET_PERIOD = 250;
+
+ConfigWatcher::ConfigWatcher () :
+    configDirty(false),
+    mapDirty(false),
+    stopping(false),
+    fd(-1)
+{
+    for (Watch &watch : watches)
+    {
+        watch.descriptor = -1;
+    }
+}
+
+ConfigWatcher::~ConfigWatcher ()
+{
+    stop();
+}
+
+// Start watching the files; the mapchange path may be empty. Returns false if inotify isn't available
+bool ConfigWatcher::start (std::string configPath, std::string mapChangePath)
+{
+    stop();
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (!addWatch(WATCHED_CONFIG, configPath))
+    {
+        close(fd);
+        fd = -1;
+
+        return false;
+    }
+
+    // The configuration is still worth watching if the mapchange file's directory doesn't exist yet
+    addWatch(WATCHED_MAPCHANGE, mapChangePath);
+
+    configDirty = false;
+    mapDirty    = false;
+    stopping    = false;
+
+    worker = std::thread(&ConfigWatcher::run, this);
+
+    return true;
+}
+
+void ConfigWatcher::stop (void)
+{
+    if (worker.joinable())
+    {
+        stopping = true;
+        worker.join();
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+
+    for (Watch &watch : watches)
+    {
+        watch.descriptor = -1;
+    }
+}
+
+bool ConfigWatcher::running (void)
+{
+    return worker.joinable();
+}
+
+// Whether the configuration file has changed since the last time this was called
+bool ConfigWatcher::configChanged (void)
+{
+    return configDirty.load() && configDirty.exchange(false);
+}
+
+// Whether the mapchange file has changed since the last time this was called, along with the map it now names
+bool ConfigWatcher::mapChanged (std::string &_mapName)
+{
+    if (!mapDirty.load() || !mapDirty.exchange(false))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    _mapName = mapName;
+
+    return true;
+}
+
+// The mapchange file holds the name of the map's configuration file; the map is named after it without the '.conf'
+std::string ConfigWatcher::readMapName (std::string mapChangePath)
+{
+    std::ifstream infile(mapChangePath.c_str());
+    std::string   name;
+
+    getline(infile, name);
+
+    if (name.size() >= 5 && name.compare(name.size() - 5, 5, ".conf") == 0)
+    {
+        name.erase(name.size() - 5);
+    }
+
+    return name;
+}
+
+bool ConfigWatcher::addWatch (WatchedFile file, std::string path)
+{
+    if (path.empty())
+    {
+        return false;
+    }
+
+    size_t separator = path.rfind('/');
+    std::string directory = (separator == std::string::npos) ? "." : (separator == 0) ? "/" : path.substr(0, separator);
+
+    watches[file].path       = path;
+    watches[file].name       = (separator == std::string::npos) ? path : path.substr(separator + 1);
+    watches[file].descriptor = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+    return (watches[file].descriptor >= 0);
+}
+
+void ConfigWatcher::run (void)
+{
+    // Events are always aligned to the size of the struct so the buffer has to be as well
+    alignas(struct inotify_event) char buffer[4096];
+    bool dirty[LAST_WATCHED_FILE] = { false, false };
+
+    while (!stopping)
+    {
+        bool waiting = dirty[WATCHED_CONFIG] || dirty[WATCHED_MAPCHANGE];
+
+        struct pollfd descriptor;
+        descriptor.fd      = fd;
+        descriptor.events  = POLLIN;
+        descriptor.revents = 0;
+
+        // Wake up regularly to check if we're being stopped, or sooner if there's a change waiting for things to settle
+        int ready = poll(&descriptor, 1, waiting ? QUIET_PERIOD : 500);
+
+        if (ready == 0 && waiting)
+        {
+            publish(dirty);
+            continue;
+        }
+
+        if (ready <= 0)
+        {
+            continue;
+        }
+
+        ssize_t length;
+
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char *ptr = buffer; ptr < buffer + length; )
+            {
+                const struct inotify_event *event = (const struct inotify_event*)ptr;
+
+                for (int file = 0; file < LAST_WATCHED_FILE; file++)
+                {
+                    // If events were lost, anything could have changed
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        dirty[file] = (watches[file].descriptor >= 0);
+                    }
+                    else if (event->wd == watches[file].descriptor && event->len > 0 && watches[file].name == event->name)
+                    {
+                        dirty[file] = true;
+                    }
+                }
+
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+}
+
+void ConfigWatcher::publish (bool dirty[LAST_WATCHED_FILE])
+{
+    if (dirty[WATCHED_MAPCHANGE])
+    {
+        std::string name = readMapName(watches[WATCHED_MAPCHANGE].path);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            mapName = name;
+        }
+
+        mapDirty = true;
+    }
+
+    if (dirty[WATCHED_CONFIG])
+    {
+        configDirty = true;
+    }
+
+    dirty[WATCHED_CONFIG]    = false;
+    dirty[WATCHED_MAPCHANGE] = false;
+}
\ No newline at end of file
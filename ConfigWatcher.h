@@ -0,0 +1,78 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CONFIG_WATCHER_H__
+#define __CONFIG_WATCHER_H__
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches the configuration file and the mapchange file for changes with inotify. The directories holding the files
+// are watched rather than the files themselves so editors that save by replacing the file are noticed too. A burst of
+// writes is only reported once things have been quiet for a moment, and the new map name is read by the worker so
+// the tick handler only has to check a flag. Like the other workers, this never touches the BZFS API.
+class ConfigWatcher
+{
+    public:
+        ConfigWatcher ();
+        ~ConfigWatcher ();
+
+        bool start   (std::string configPath, std::string mapChangePath);
+        void stop    (void);
+        bool running (void);
+
+        bool configChanged (void);
+        bool mapChanged    (std::string &mapName);
+
+        static std::string readMapName (std::string mapChangePath);
+
+    private:
+        enum WatchedFile
+        {
+            WATCHED_CONFIG,
+            WATCHED_MAPCHANGE,
+            LAST_WATCHED_FILE
+        };
+
+        struct Watch
+        {
+            std::string path,
+                        name;       // The name of the file inside of the watched directory
+            int         descriptor;
+        };
+
+        Watch             watches[LAST_WATCHED_FILE];
+
+        std::thread       worker;
+        std::mutex        mutex;
+        std::string       mapName;
+        std::atomic<bool> configDirty,
+                          mapDirty,
+                          stopping;
+
+        int               fd;
+
+        bool addWatch (WatchedFile file, std::string path);
+        void run      (void);
+        void publish  (bool dirty[LAST_WATCHED_FILE]);
+};
+
+#endif
\ No newline at end of file
@@ -27,11 +27,17 @@ League Overseer
 
 ConfigurationOptions::ConfigurationOptions ()
 {
+    stringConfigValues["REPLAY_ARCHIVE_PATH"]      = "";
+    stringConfigValues["REPLAY_DIRECTORY"]         = "";
     stringConfigValues["SPAWN_COMMAND_PERM"]       = "ban";
     stringConfigValues["MATCH_REPORT_URL"]         = "";
+    stringConfigValues["REPORT_RELAY_SOCKET"]      = "";
     stringConfigValues["SHOW_HIDDEN_PERM"]         = "ban";
     stringConfigValues["MAPCHANGE_PATH"]           = "";
+    stringConfigValues["METRICS_FILE"]             = "";
+    stringConfigValues["TEAM_CACHE_NAME"]          = "";
     stringConfigValues["TEAM_NAME_URL"]            = "";
+    stringConfigValues["TIMELINE_DIRECTORY"]       = "";
     stringConfigValues["LEAGUE_GROUP"]             = "VERIFIED";
 
     boolConfigValues["INTER_PLUGIN_COM_API_CHECK"] = false;
@@ -42,23 +48,42 @@ ConfigurationOptions::ConfigurationOptions ()
     boolConfigValues["MATCH_REPORT_ENABLED"]       = true;
     boolConfigValues["TALK_MESSAGE_ENABLED"]       = true;
     boolConfigValues["MOTTO_FETCH_ENABLED"]        = true;
+    boolConfigValues["MUTE_LIST_ENABLED"]          = false;
     boolConfigValues["DISABLE_FUN_MATCHES"]        = false;
     boolConfigValues["ALLOW_LIMITED_CHAT"]         = true;
     boolConfigValues["ROTATIONAL_LEAGUE"]          = false;
+    boolConfigValues["REPLAY_ARCHIVE_ENABLED"]     = false;
 
     intConfigValues["DEFAULT_TIME_LIMIT"]          = defaultTimeLimit;
+    intConfigValues["METRICS_INTERVAL"]            = 15;
+    intConfigValues["MUTE_LIST_REFRESH"]           = 5;
+    intConfigValues["REPLAY_FUN_MAX_COUNT"]        = 0;
+    intConfigValues["REPLAY_FUN_MAX_SIZE"]         = 0;
+    intConfigValues["REPLAY_OFFICIAL_MAX_COUNT"]   = 0;
+    intConfigValues["REPLAY_OFFICIAL_MAX_SIZE"]    = 0;
+    intConfigValues["TEAM_CACHE_REFRESH"]          = 60;
     intConfigValues["VERBOSE_LEVEL"]               = 4;
     intConfigValues["DEBUG_LEVEL"]                 = 1;
 }
 
-void ConfigurationOptions::readConfigurationFile(const char* filePath)
+// When reloading, the caller keeps its current settings if the file can't be read, so say that instead of promising
+// the defaults
+bool ConfigurationOptions::readConfigurationFile(const char* filePath, bool reloading)
 {
     pluginConfigObj = PluginConfig(filePath);
 
     if (pluginConfigObj.errors)
     {
-        logMessage(0, "error", "Your configuration file has one or more errors. Using default configuration values.");
-        return;
+        if (reloading)
+        {
+            logMessage(0, "error", "Your configuration file has one or more errors. The current configuration values have been kept.");
+        }
+        else
+        {
+            logMessage(0, "error", "Your configuration file has one or more errors. Using default configuration values.");
+        }
+
+        return false;
     }
 
     // A short cut configuration value that will take the value of two separate configuration values
@@ -68,7 +93,7 @@ void ConfigurationOptions::readConfigurationFile(const char* filePath)
         stringConfigValues["TEAM_NAME_URL"]    = getString("LEAGUE_OVERSEER_URL");
     }
 
-    for (auto option : stringConfigOptions)
+    for (auto option : vectorConfigOptions)
     {
         if (isOptionSet(option.c_str()))
         {
@@ -101,16 +126,58 @@ void ConfigurationOptions::readConfigurationFile(const char* filePath)
     }
 
     sanityChecks();
+
+    return true;
+}
+
+template <typename T>
+static void diffValues (const std::map<std::string, T> &current, const std::map<std::string, T> &updated, std::vector<std::string> &changed)
+{
+    for (auto &option : updated)
+    {
+        auto it = current.find(option.first);
+
+        if (it == current.end() || it->second != option.second)
+        {
+            changed.push_back(option.first);
+        }
+    }
+
+    for (auto &option : current)
+    {
+        if (updated.find(option.first) == updated.end())
+        {
+            changed.push_back(option.first);
+        }
+    }
+}
+
+// Get the names of the options whose values differ between these settings and another set of settings
+std::vector<std::string> ConfigurationOptions::diff (const ConfigurationOptions &other) const
+{
+    std::vector<std::string> changed;
+
+    diffValues(vectorConfigValues, other.vectorConfigValues, changed);
+    diffValues(stringConfigValues, other.stringConfigValues, changed);
+    diffValues(boolConfigValues,   other.boolConfigValues,   changed);
+    diffValues(intConfigValues,    other.intConfigValues,    changed);
+
+    return changed;
 }
 
 std::vector<std::string> ConfigurationOptions::getNoSpawnMessage (void) { return vectorConfigValues["NO_SPAWN_MESSAGE"]; }
 std::vector<std::string> ConfigurationOptions::getNoTalkMessage  (void) { return vectorConfigValues["NO_TALK_MESSAGE"]; }
 
+std::string ConfigurationOptions::getReplayDirectory  (void) { return stringConfigValues["REPLAY_DIRECTORY"]; }
 std::string ConfigurationOptions::getSpawnCommandPerm (void) { return stringConfigValues["SPAWN_COMMAND_PERM"]; }
 std::string ConfigurationOptions::getMatchReportURL   (void) { return stringConfigValues["MATCH_REPORT_URL"]; }
+std::string ConfigurationOptions::getReportRelaySocket (void) { return stringConfigValues["REPORT_RELAY_SOCKET"]; }
 std::string ConfigurationOptions::getShowHiddenPerm   (void) { return stringConfigValues["SHOW_HIDDEN_PERM"]; }
 std::string ConfigurationOptions::getMapChangePath    (void) { return stringConfigValues["MAPCHANGE_PATH"]; }
+std::string ConfigurationOptions::getMetricsFile      (void) { return stringConfigValues["METRICS_FILE"]; }
+std::string ConfigurationOptions::getTeamCacheName    (void) { return stringConfigValues["TEAM_CACHE_NAME"]; }
 std::string ConfigurationOptions::getTeamNameURL      (void) { return stringConfigValues["TEAM_NAME_URL"]; }
+std::string ConfigurationOptions::getTimelineDirectory (void) { return stringConfigValues["TIMELINE_DIRECTORY"]; }
 std::string ConfigurationOptions::getLeagueGroup      (void) { return stringConfigValues["LEAGUE_GROUP"]; }
 
 bool ConfigurationOptions::areOfficialMatchesDisabled (void) { return boolConfigValues["DISABLE_OFFICIAL_MATCHES"]; }
@@ -123,13 +190,44 @@ bool ConfigurationOptions::isInGameDebugEnabled       (void) { return boolConfig
 bool ConfigurationOptions::isMatchReportEnabled       (void) { return boolConfigValues["MATCH_REPORT_ENABLED"]; }
 bool ConfigurationOptions::isTalkMessageEnabled       (void) { return boolConfigValues["TALK_MESSAGE_ENABLED"]; }
 bool ConfigurationOptions::isMottoFetchEnabled        (void) { return boolConfigValues["MOTTO_FETCH_ENABLED"]; }
+bool ConfigurationOptions::isMuteListEnabled          (void) { return boolConfigValues["MUTE_LIST_ENABLED"]; }
 bool ConfigurationOptions::isAllowLimitedChat         (void) { return boolConfigValues["ALLOW_LIMITED_CHAT"]; }
 bool ConfigurationOptions::isRotationalLeague         (void) { return boolConfigValues["ROTATIONAL_LEAGUE"]; }
+bool ConfigurationOptions::isReplayArchiveEnabled     (void) { return boolConfigValues["REPLAY_ARCHIVE_ENABLED"]; }
 
 int  ConfigurationOptions::getDefaultTimeLimit        (void) { return intConfigValues["DEFAULT_TIME_LIMIT"]; }
+int  ConfigurationOptions::getMetricsInterval         (void) { return intConfigValues["METRICS_INTERVAL"]; }
+int  ConfigurationOptions::getMuteListRefresh         (void) { return intConfigValues["MUTE_LIST_REFRESH"]; }
+int  ConfigurationOptions::getFunReplayMaxCount       (void) { return intConfigValues["REPLAY_FUN_MAX_COUNT"]; }
+int  ConfigurationOptions::getFunReplayMaxSize        (void) { return intConfigValues["REPLAY_FUN_MAX_SIZE"]; }
+int  ConfigurationOptions::getOfficialReplayMaxCount  (void) { return intConfigValues["REPLAY_OFFICIAL_MAX_COUNT"]; }
+int  ConfigurationOptions::getOfficialReplayMaxSize   (void) { return intConfigValues["REPLAY_OFFICIAL_MAX_SIZE"]; }
+int  ConfigurationOptions::getTeamCacheRefresh        (void) { return intConfigValues["TEAM_CACHE_REFRESH"]; }
 int  ConfigurationOptions::getVerboseLevel            (void) { return intConfigValues["VERBOSE_LEVEL"]; }
 int  ConfigurationOptions::getDebugLevel              (void) { return intConfigValues["DEBUG_LEVEL"]; }
 
+// Old replays are only removed if the server owner has given at least one budget and we know where the replays are
+bool ConfigurationOptions::isReplayRetentionEnabled (void)
+{
+    if (getReplayDirectory().empty())
+    {
+        return false;
+    }
+
+    return (getFunReplayMaxCount() > 0 || getFunReplayMaxSize() > 0 || getOfficialReplayMaxCount() > 0 || getOfficialReplayMaxSize() > 0);
+}
+
+// The archive lives inside of the replay directory unless the server owner has put it somewhere else
+std::string ConfigurationOptions::getReplayArchivePath (void)
+{
+    if (stringConfigValues["REPLAY_ARCHIVE_PATH"].empty() && !getReplayDirectory().empty())
+    {
+        return getReplayDirectory() + "/archive";
+    }
+
+    return stringConfigValues["REPLAY_ARCHIVE_PATH"];
+}
+
 bool ConfigurationOptions::isOptionSet(const char* itemName)
 {
     return (!pluginConfigObj.item("LeagueOverseer", itemName).empty());
@@ -174,6 +272,49 @@ void ConfigurationOptions::sanityChecks()
         logMessage(0, "error", "If you do not wish to team names for mottos, set 'DISABLE_TEAM_MOTTO' to true.");
     }
 
+    if (isReplayArchiveEnabled() && getReplayDirectory().empty())
+    {
+        boolConfigValues["REPLAY_ARCHIVE_ENABLED"] = false;
+        logMessage(0, "error", "You have enabled replay archiving but have not specified where BZFS saves replays. Please set");
+        logMessage(0, "error", "the 'REPLAY_DIRECTORY' option to the same directory as the -recdir option. Replays will not be archived.");
+    }
+
+    if (getReplayDirectory().empty() && (getFunReplayMaxCount() > 0 || getFunReplayMaxSize() > 0 || getOfficialReplayMaxCount() > 0 || getOfficialReplayMaxSize() > 0))
+    {
+        logMessage(0, "error", "You have set a replay budget but have not specified where BZFS saves replays. Please set the");
+        logMessage(0, "error", "'REPLAY_DIRECTORY' option to the same directory as the -recdir option. Old replays will not be removed.");
+    }
+
+    if (isMuteListEnabled() && getTeamNameURL().empty())
+    {
+        boolConfigValues["MUTE_LIST_ENABLED"] = false;
+        logMessage(0, "error", "You have enabled the league mute list but have not specified a URL to fetch it from.");
+        logMessage(0, "error", "Please set the 'TEAM_NAME_URL' or 'LEAGUE_OVERSEER_URL' option respectively.");
+    }
+
+    if (getMetricsInterval() < 1)
+    {
+        intConfigValues["METRICS_INTERVAL"] = 15;
+        logMessage(0, "warning", "The 'METRICS_INTERVAL' option must be at least 1 second. The default of 15 seconds will be used.");
+    }
+
+    if (getMuteListRefresh() < 1)
+    {
+        intConfigValues["MUTE_LIST_REFRESH"] = 5;
+        logMessage(0, "warning", "The 'MUTE_LIST_REFRESH' option must be at least 1 minute. The default of 5 minutes will be used.");
+    }
+
+    if (!getTeamCacheName().empty() && getTeamCacheName()[0] != '/')
+    {
+        stringConfigValues["TEAM_CACHE_NAME"] = "/" + getTeamCacheName();
+    }
+
+    if (getTeamCacheRefresh() < 1)
+    {
+        intConfigValues["TEAM_CACHE_REFRESH"] = 60;
+        logMessage(0, "warning", "The 'TEAM_CACHE_REFRESH' option must be at least 1 minute. The default of 60 minutes will be used.");
+    }
+
     if (getDebugLevel() > 4 || getDebugLevel() < 0)
     {
         intConfigValues["DEBUG_LEVEL"] = 1;
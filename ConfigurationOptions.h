@@ -30,16 +30,24 @@ class ConfigurationOptions
     public:
         ConfigurationOptions ();
 
-        void readConfigurationFile(const char* filePath);
+        bool readConfigurationFile(const char* filePath, bool reloading = false);
+
+        std::vector<std::string> diff (const ConfigurationOptions &other) const;
 
         std::vector<std::string> getNoSpawnMessage (void);
         std::vector<std::string> getNoTalkMessage  (void);
 
+        std::string getReplayArchivePath (void);
+        std::string getReplayDirectory  (void);
         std::string getSpawnCommandPerm (void);
         std::string getMatchReportURL   (void);
+        std::string getReportRelaySocket (void);
         std::string getShowHiddenPerm   (void);
         std::string getMapChangePath    (void);
+        std::string getMetricsFile      (void);
+        std::string getTeamCacheName    (void);
         std::string getTeamNameURL      (void);
+        std::string getTimelineDirectory (void);
         std::string getLeagueGroup      (void);
 
         bool areOfficialMatchesDisabled (void);
@@ -52,10 +60,20 @@ class ConfigurationOptions
         bool isMatchReportEnabled       (void);
         bool isTalkMessageEnabled       (void);
         bool isMottoFetchEnabled        (void);
+        bool isMuteListEnabled          (void);
+        bool isReplayArchiveEnabled     (void);
+        bool isReplayRetentionEnabled   (void);
         bool isAllowLimitedChat         (void);
         bool isRotationalLeague         (void);
 
         int  getDefaultTimeLimit        (void);
+        int  getFunReplayMaxCount       (void);
+        int  getMetricsInterval         (void);
+        int  getMuteListRefresh         (void);
+        int  getFunReplayMaxSize        (void);
+        int  getOfficialReplayMaxCount  (void);
+        int  getOfficialReplayMaxSize   (void);
+        int  getTeamCacheRefresh        (void);
         int  getVerboseLevel            (void);
         int  getDebugLevel              (void);
 
@@ -69,11 +87,17 @@ class ConfigurationOptions
                                                        };
 
         std::vector<std::string> stringConfigOptions = {
+                                                            "REPLAY_ARCHIVE_PATH",      // The directory saved replays are compressed and archived into
+                                                            "REPLAY_DIRECTORY",         // The directory BZFS saves replays to (the -recdir option)
                                                             "SPAWN_COMMAND_PERM",       // The BZFS permission required to use the /spawn command
                                                             "MATCH_REPORT_URL",         // The URL the plugin will use to report matches
+                                                            "REPORT_RELAY_SOCKET",      // The socket of the LeagueOverseerRelay daemon that sends our requests to the league site
                                                             "SHOW_HIDDEN_PERM",         // The BZFS permission required to use the /showhidden command
                                                             "MAPCHANGE_PATH",           // The path to the file that contains the name of current map being played
+                                                            "METRICS_FILE",             // The file the plug-in's metrics are written to for node_exporter's textfile collector
+                                                            "TEAM_CACHE_NAME",          // The name of the shared memory segment team names are shared with other servers on this host through
                                                             "TEAM_NAME_URL",            // The URL the plugin will use to fetch team information
+                                                            "TIMELINE_DIRECTORY",       // The directory the binary timeline of each official match is written to
                                                             "LEAGUE_GROUP"              // The BZBB group that signifies membership of a league (typically in the format of <something>.LEAGUE)
                                                        };
 
@@ -86,14 +110,23 @@ class ConfigurationOptions
                                                             "MATCH_REPORT_ENABLED",     // Whether or not to enable automatic match reports if a server is not used as an official match server
                                                             "TALK_MESSAGE_ENABLED",     // Whether or not to send custom messages explaining why players can't talk
                                                             "MOTTO_FETCH_ENABLED",      // Whether or not to set a player's motto to their team name
+                                                            "MUTE_LIST_ENABLED",        // Whether or not to download the league's mute list and silence the players on it
                                                             "DISABLE_FUN_MATCHES",      // Whether or not fun matches have been disabled on this server
                                                             "ALLOW_LIMITED_CHAT",       // Whether or not to allow limited chat functionality for non-league players
                                                             "IGNORE_TIME_CHECKS",       // Whether or not to check for the DEFAULT_TIME_LIMIT to be sane
+                                                            "REPLAY_ARCHIVE_ENABLED",   // Whether or not to compress, hash and archive replays in the background
                                                             "ROTATIONAL_LEAGUE"         // Whether or not we are watching a league that uses different maps
                                                        };
 
         std::vector<std::string> intConfigOptions    = {
                                                             "DEFAULT_TIME_LIMIT",       // The default time limit each match will have
+                                                            "METRICS_INTERVAL",         // The number of seconds between writes of the metrics file
+                                                            "MUTE_LIST_REFRESH",        // The number of minutes between checks for changes to the league's mute list
+                                                            "REPLAY_FUN_MAX_COUNT",     // The most fun match replays to keep on disk; 0 for no limit
+                                                            "REPLAY_FUN_MAX_SIZE",      // The most megabytes of fun match replays to keep on disk; 0 for no limit
+                                                            "REPLAY_OFFICIAL_MAX_COUNT", // The most official match replays to keep on disk; 0 for no limit
+                                                            "REPLAY_OFFICIAL_MAX_SIZE", // The most megabytes of official match replays to keep on disk; 0 for no limit
+                                                            "TEAM_CACHE_REFRESH",       // The number of minutes between downloads of the shared team name table
                                                             "VERBOSE_LEVEL",            // This is the spamming/ridiculous level of debug that the plugin uses
                                                             "DEBUG_LEVEL"               // The DEBUG level the server owner wants the plugin to use for its messages
                                                        };
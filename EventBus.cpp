@@ -0,0 +1,123 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "EventBus.h"
+
+EventBus::EventBus () :
+    nextID(1),
+    publishing(0),
+    removed(false)
+{}
+
+int EventBus::subscribe (LosEventSubscription* subscription)
+{
+    if (!subscription || subscription->version != LOS_EVENT_BUS_VERSION || (!subscription->callback && !subscription->ring))
+    {
+        return 0;
+    }
+
+    if (subscription->ring && subscription->ring->capacity == 0)
+    {
+        return 0;
+    }
+
+    subscription->id = nextID++;
+    subscribers.push_back(*subscription);
+
+    return subscription->id;
+}
+
+bool EventBus::unsubscribe (LosEventSubscription* subscription)
+{
+    if (!subscription)
+    {
+        return false;
+    }
+
+    if (subscription->id == 0)
+    {
+        return false;
+    }
+
+    for (std::vector<LosEventSubscription>::iterator it = subscribers.begin(); it != subscribers.end(); ++it)
+    {
+        if (it->id == subscription->id)
+        {
+            // A subscriber may unsubscribe itself or another one from a callback; erasing it now would shift the one
+            // publish() is about to call next, so it's only switched off until the publish is done
+            if (publishing > 0)
+            {
+                it->id  = 0;
+                removed = true;
+            }
+            else
+            {
+                subscribers.erase(it);
+            }
+
+            subscription->id = 0;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EventBus::publish (const LosBusEvent &event)
+{
+    publishing++;
+
+    // Subscriptions made by a callback start with the next event
+    size_t count = subscribers.size();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // Copied because a callback that subscribes may move the vector's storage
+        LosEventSubscription subscriber = subscribers.at(i);
+
+        if (subscriber.id == 0 || (subscriber.mask != 0 && !(subscriber.mask & LOS_EVENT_MASK(event.type))))
+        {
+            continue;
+        }
+
+        if (subscriber.ring)
+        {
+            subscriber.ring->push(event);
+        }
+
+        if (subscriber.callback)
+        {
+            subscriber.callback(event, subscriber.userData);
+        }
+    }
+
+    if (--publishing == 0 && removed)
+    {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const LosEventSubscription &s) { return s.id == 0; }),
+                          subscribers.end());
+        removed = false;
+    }
+}
+
+bool EventBus::hasSubscribers (void)
+{
+    return !subscribers.empty();
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __EVENT_BUS_H__
+#define __EVENT_BUS_H__
+
+#include <atomic>
+#include <vector>
+
+// The layout version of the structs in this header. Subscriptions made with a different version are refused.
+const int LOS_EVENT_BUS_VERSION = 1;
+
+enum LosBusEventType
+{
+    LOS_EVENT_MATCH_START,  // A match has started
+    LOS_EVENT_MATCH_END,    // A match has ended normally or was ended early with /finish
+    LOS_EVENT_MATCH_CANCEL, // A match was canceled; 'detail' holds the reason
+    LOS_EVENT_CAPTURE,      // A capture that counted toward the score of an official match
+    LOS_EVENT_ROLL_CALL,    // The roll call of an official match; 'success' is false if it has to be redone
+    LOS_EVENT_SUBSTITUTE,   // A player subbed in ('success' is true) or out of an official match
+    LOS_EVENT_LAST
+};
+
+// The bit to set in LosEventSubscription::mask to receive a type of event
+#define LOS_EVENT_MASK(type) (1u << (type))
+
+struct LosBusEvent
+{
+    int    type;          // A LosBusEventType value
+
+    bool   official,      // Whether or not the event belongs to an official match
+           success;       // See LosBusEventType for the meaning in each event
+
+    int    playerID,      // The player that caused the event or -1
+           team,          // The bz_eTeamType of the player or of the capturing team
+           otherTeam,     // The bz_eTeamType of the team whose flag was captured
+           teamOneScore,
+           teamTwoScore;
+
+    double eventTime;     // The server time the event occurred at
+
+    char   bzID[32],      // The BZID of the player, if there is one
+           detail[128];   // Extra text for the event, such as a cancellation reason or "Team One vs Team Two"
+};
+
+// A bounded ring buffer that a subscriber can own and drain whenever it likes instead of receiving a callback. League
+// Overseer is the only producer; when the ring is full new events are counted in 'dropped' and discarded.
+class LosEventRing
+{
+    public:
+        LosEventRing (LosBusEvent* _storage, unsigned int _capacity) :
+            storage(_storage), capacity(_capacity), head(0), tail(0), dropped(0)
+        {}
+
+        bool push (const LosBusEvent &event)
+        {
+            unsigned int currentTail = tail.load(std::memory_order_relaxed);
+
+            if (currentTail - head.load(std::memory_order_acquire) >= capacity)
+            {
+                dropped++;
+                return false;
+            }
+
+            storage[currentTail % capacity] = event;
+            tail.store(currentTail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool pop (LosBusEvent &event)
+        {
+            unsigned int currentHead = head.load(std::memory_order_relaxed);
+
+            if (currentHead == tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            event = storage[currentHead % capacity];
+            head.store(currentHead + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        LosBusEvent*              storage;
+        unsigned int              capacity;
+        std::atomic<unsigned int> head,
+                                  tail;
+        unsigned int              dropped;
+};
+
+typedef void (*LosEventCallback)(const LosBusEvent &event, void* userData);
+
+// Passed to the 'SubscribeMatchEvents' generic callback, which returns the ID of the subscription or 0 on failure.
+// Pass the same struct to 'UnsubscribeMatchEvents' before the subscribing plug-in is unloaded. Either a callback or
+// a ring has to be set; if both are set, both will receive events.
+struct LosEventSubscription
+{
+    int              version;   // Set to LOS_EVENT_BUS_VERSION
+    int              id;        // Filled in by League Overseer
+
+    unsigned int     mask;      // A combination of LOS_EVENT_MASK() values or 0 for every event
+
+    LosEventCallback callback;
+    void*            userData;
+
+    LosEventRing*    ring;
+};
+
+class EventBus
+{
+    public:
+        EventBus ();
+
+        int  subscribe   (LosEventSubscription* subscription);
+        bool unsubscribe (LosEventSubscription* subscription);
+        void publish     (const LosBusEvent &event);
+        bool hasSubscribers (void);
+
+    private:
+        std::vector<LosEventSubscription> subscribers;
+
+        int nextID,
+            publishing;     // How many publish() calls are on the stack; removals wait until it's back to 0
+        bool removed;       // Subscriptions were removed during a publish() and still have to be erased
+};
+
+#endif
\ No newline at end of file
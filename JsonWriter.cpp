@@ -0,0 +1,235 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <cstdio>
+
+#include "JsonWriter.h"
+
+JsonWriter::JsonWriter (size_t capacity) :
+    needsComma(false)
+{
+    buffer.reserve(capacity);
+}
+
+JsonWriter& JsonWriter::beginObject (void)
+{
+    separate();
+    buffer += '{';
+    needsComma = false;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject (void)
+{
+    buffer += '}';
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray (void)
+{
+    separate();
+    buffer += '[';
+    needsComma = false;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray (void)
+{
+    buffer += ']';
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::key (const char* name)
+{
+    separate();
+    appendEscaped(name);
+    buffer += ':';
+
+    // The value that follows a key must never be prefixed with a comma
+    needsComma = false;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::value (const std::string &value)
+{
+    return this->value(value.c_str());
+}
+
+JsonWriter& JsonWriter::value (const char* value)
+{
+    if (value == NULL)
+    {
+        return null();
+    }
+
+    separate();
+    appendEscaped(value);
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::value (double value)
+{
+    // JSON has no representation for NaN or infinity
+    if (!std::isfinite(value))
+    {
+        return null();
+    }
+
+    char number[32];
+    int  length = snprintf(number, sizeof(number), "%.17g", value);
+
+    separate();
+    buffer.append(number, length);
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::value (bool value)
+{
+    separate();
+    buffer += (value) ? "true" : "false";
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::value (int value)
+{
+    return this->value((long long)value);
+}
+
+JsonWriter& JsonWriter::value (long long value)
+{
+    char number[24];
+    int  length = snprintf(number, sizeof(number), "%lld", value);
+
+    separate();
+    buffer.append(number, length);
+    needsComma = true;
+
+    return *this;
+}
+
+JsonWriter& JsonWriter::null (void)
+{
+    separate();
+    buffer += "null";
+    needsComma = true;
+
+    return *this;
+}
+
+// Append JSON that has already been serialized, such as an event that was built by another writer
+JsonWriter& JsonWriter::raw (const char* json)
+{
+    separate();
+    buffer += json;
+    needsComma = true;
+
+    return *this;
+}
+
+void JsonWriter::reset (void)
+{
+    // std::string::clear() keeps the capacity of the buffer so we can reuse the memory
+    buffer.clear();
+    needsComma = false;
+}
+
+const std::string& JsonWriter::str (void) const
+{
+    return buffer;
+}
+
+const char* JsonWriter::c_str (void) const
+{
+    return buffer.c_str();
+}
+
+size_t JsonWriter::size (void) const
+{
+    return buffer.size();
+}
+
+bool JsonWriter::empty (void) const
+{
+    return buffer.empty();
+}
+
+void JsonWriter::separate (void)
+{
+    if (needsComma)
+    {
+        buffer += ',';
+    }
+}
+
+void JsonWriter::appendEscaped (const char* str)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    buffer += '"';
+
+    // Copy runs of characters that don't need escaping in one go instead of a character at a time
+    const char* run = str;
+
+    for (const char* c = str; *c != '\0'; c++)
+    {
+        unsigned char current = (unsigned char)*c;
+
+        if (current >= 0x20 && current != '"' && current != '\\')
+        {
+            continue;
+        }
+
+        buffer.append(run, c - run);
+        run = c + 1;
+
+        switch (current)
+        {
+            case '"':  buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\b': buffer += "\\b";  break;
+            case '\f': buffer += "\\f";  break;
+            case '\n': buffer += "\\n";  break;
+            case '\r': buffer += "\\r";  break;
+            case '\t': buffer += "\\t";  break;
+
+            default:
+            {
+                char escaped[] = { '\\', 'u', '0', '0', hexDigits[current >> 4], hexDigits[current & 0xF] };
+                buffer.append(escaped, sizeof(escaped));
+            }
+            break;
+        }
+    }
+
+    buffer += run;
+    buffer += '"';
+}
\ No newline at end of file
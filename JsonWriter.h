@@ -0,0 +1,68 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __JSON_WRITER_H__
+#define __JSON_WRITER_H__
+
+#include <string>
+
+// A streaming JSON writer that appends escaped output directly into a buffer. Calling reset() empties the buffer
+// but keeps its capacity, so a writer that is reused will stop allocating once it has grown to fit its output.
+class JsonWriter
+{
+    public:
+        JsonWriter (size_t capacity = 256);
+
+        JsonWriter& beginObject (void);
+        JsonWriter& endObject   (void);
+        JsonWriter& beginArray  (void);
+        JsonWriter& endArray    (void);
+
+        JsonWriter& key   (const char* name);
+        JsonWriter& value (const std::string &value);
+        JsonWriter& value (const char* value);
+        JsonWriter& value (double value);
+        JsonWriter& value (bool value);
+        JsonWriter& value (int value);
+        JsonWriter& value (long long value);
+        JsonWriter& null  (void);
+        JsonWriter& raw   (const char* json);
+
+        template<typename T>
+        JsonWriter& set (const char* name, const T &_value)
+        {
+            return key(name).value(_value);
+        }
+
+        void reset (void);
+
+        const std::string& str   (void) const;
+        const char*        c_str (void) const;
+        size_t             size  (void) const;
+        bool               empty (void) const;
+
+    private:
+        std::string buffer;
+
+        bool        needsComma;
+
+        void separate      (void);
+        void appendEscaped (const char* str);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,466 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A standalone tool that re-derives player and team stats from the match timelines the plug-in writes to its
+// TIMELINE_DIRECTORY. Every timeline under the given directory is mapped into memory and processed on a pool of
+// worker threads; each worker keeps its own totals, which are merged and printed as JSON once all of them finish.
+//
+//     Usage: LeagueOverseerAnalyzer [-j threads] <directory>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "JsonWriter.h"
+#include "MatchTimeline.h"
+
+// The bz_eTeamType values the plug-in writes, in order
+static const char* TEAM_NAMES[] = { "Rogue", "Red", "Green", "Blue", "Purple", "Rabbit", "Hunter", "Observer" };
+
+static const uint8_t OBSERVER_TEAM = 7;
+
+struct PlayerStats
+{
+    long long matches, captures, kills, deaths, teamKills, suicides, secondsPlayed;
+
+    PlayerStats () : matches(0), captures(0), kills(0), deaths(0), teamKills(0), suicides(0), secondsPlayed(0) {}
+};
+
+struct TeamStats
+{
+    long long matches, wins, losses, draws, pointsFor, pointsAgainst;
+
+    TeamStats () : matches(0), wins(0), losses(0), draws(0), pointsFor(0), pointsAgainst(0) {}
+};
+
+struct Totals
+{
+    long long matches, canceled, incomplete, invalid;
+
+    std::map<std::string, PlayerStats> players;
+    std::map<std::string, TeamStats>   teams;
+
+    Totals () : matches(0), canceled(0), incomplete(0), invalid(0) {}
+
+    void merge (const Totals &other)
+    {
+        matches    += other.matches;
+        canceled   += other.canceled;
+        incomplete += other.incomplete;
+        invalid    += other.invalid;
+
+        for (auto &player : other.players)
+        {
+            PlayerStats &stats = players[player.first];
+
+            stats.matches       += player.second.matches;
+            stats.captures      += player.second.captures;
+            stats.kills         += player.second.kills;
+            stats.deaths        += player.second.deaths;
+            stats.teamKills     += player.second.teamKills;
+            stats.suicides      += player.second.suicides;
+            stats.secondsPlayed += player.second.secondsPlayed;
+        }
+
+        for (auto &team : other.teams)
+        {
+            TeamStats &stats = teams[team.first];
+
+            stats.matches       += team.second.matches;
+            stats.wins          += team.second.wins;
+            stats.losses        += team.second.losses;
+            stats.draws         += team.second.draws;
+            stats.pointsFor     += team.second.pointsFor;
+            stats.pointsAgainst += team.second.pointsAgainst;
+        }
+    }
+};
+
+static bool endsWith (const std::string &str, const char* suffix)
+{
+    std::string ending(suffix);
+
+    return str.size() >= ending.size() && str.compare(str.size() - ending.size(), ending.size(), ending) == 0;
+}
+
+static void findTimelines (std::string directory, std::vector<std::string> &timelines)
+{
+    DIR* handle = opendir(directory.c_str());
+
+    if (!handle)
+    {
+        return;
+    }
+
+    struct dirent* entry;
+
+    while ((entry = readdir(handle)) != NULL)
+    {
+        std::string name = entry->d_name;
+
+        if (name == "." || name == "..")
+        {
+            continue;
+        }
+
+        std::string path = directory + "/" + name;
+        struct stat info;
+
+        if (stat(path.c_str(), &info) != 0)
+        {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode))
+        {
+            findTimelines(path, timelines);
+        }
+        else if (S_ISREG(info.st_mode) && endsWith(name, ".timeline"))
+        {
+            timelines.push_back(path);
+        }
+    }
+
+    closedir(handle);
+}
+
+static const char* teamName (int team)
+{
+    return (team >= 0 && team < (int)(sizeof(TEAM_NAMES) / sizeof(TEAM_NAMES[0]))) ? TEAM_NAMES[team] : "Unknown";
+}
+
+// Teams are counted under the league name the roll call found for them; a match whose roll call never succeeded can
+// only be counted under the colour the team played as
+static std::string teamKey (const char* name, int team)
+{
+    std::string leagueName(name, strnlen(name, MATCH_TIMELINE_TEAM_NAME_SIZE));
+
+    return (leagueName.empty()) ? teamName(team) : leagueName;
+}
+
+// A canceled match or one that never finished doesn't count towards anyone's stats. A timeline written on a host with
+// the other byte order is counted as invalid since none of its numbers can be read as they are.
+static void analyzeTimeline (const char* base, size_t size, Totals &totals)
+{
+    const MatchTimelineHeader* header = (const MatchTimelineHeader*)base;
+
+    if (size < sizeof(MatchTimelineHeader) || memcmp(header->magic, MATCH_TIMELINE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->byteOrder != MATCH_TIMELINE_BYTE_ORDER || header->version > MATCH_TIMELINE_VERSION ||
+        header->recordSize < sizeof(MatchTimelineRecord))
+    {
+        totals.invalid++;
+        return;
+    }
+
+    size_t count = (size - sizeof(MatchTimelineHeader)) / header->recordSize;
+
+    if (count == 0)
+    {
+        totals.incomplete++;
+        return;
+    }
+
+    const MatchTimelineRecord* last = (const MatchTimelineRecord*)(base + sizeof(MatchTimelineHeader) + (count - 1) * header->recordSize);
+
+    if (last->type != TIMELINE_MATCH_END)
+    {
+        totals.incomplete++;
+        return;
+    }
+
+    if (last->flags & MATCH_TIMELINE_CANCELED)
+    {
+        totals.canceled++;
+        return;
+    }
+
+    Totals match;
+    std::map<std::string, uint32_t> joinedAt;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const MatchTimelineRecord* record = (const MatchTimelineRecord*)(base + sizeof(MatchTimelineHeader) + i * header->recordSize);
+
+        // Guard against a record that was written without its terminator
+        std::string bzID(record->bzID, strnlen(record->bzID, sizeof(record->bzID))),
+                    otherBZID(record->otherBZID, strnlen(record->otherBZID, sizeof(record->otherBZID)));
+
+        switch (record->type)
+        {
+            case TIMELINE_JOIN:
+            {
+                if (!bzID.empty() && record->team != OBSERVER_TEAM && !joinedAt.count(bzID))
+                {
+                    joinedAt[bzID] = record->offset;
+                    match.players[bzID].matches = 1;
+                }
+            }
+            break;
+
+            case TIMELINE_PART:
+            {
+                auto joined = joinedAt.find(bzID);
+
+                if (joined != joinedAt.end())
+                {
+                    match.players[bzID].secondsPlayed += (record->offset - joined->second) / 1000;
+                    joinedAt.erase(joined);
+                }
+            }
+            break;
+
+            case TIMELINE_CAPTURE:
+            {
+                if (!bzID.empty())
+                {
+                    match.players[bzID].captures++;
+                }
+            }
+            break;
+
+            case TIMELINE_KILL:
+            {
+                if (bzID.empty())
+                {
+                    break;
+                }
+
+                match.players[bzID].deaths++;
+
+                if (otherBZID.empty())
+                {
+                    break;
+                }
+
+                if (otherBZID == bzID)
+                {
+                    match.players[bzID].suicides++;
+                }
+                else if (record->team == record->otherTeam && record->team != MATCH_TIMELINE_NO_TEAM)
+                {
+                    match.players[otherBZID].teamKills++;
+                }
+                else
+                {
+                    match.players[otherBZID].kills++;
+                }
+            }
+            break;
+
+            case TIMELINE_MATCH_END:
+            {
+                for (auto &joined : joinedAt)
+                {
+                    match.players[joined.first].secondsPlayed += (record->offset - joined.second) / 1000;
+                }
+
+                joinedAt.clear();
+
+                int teamOnePoints = record->values[0],
+                    teamTwoPoints = record->values[1];
+
+                TeamStats &teamOne = match.teams[teamKey(header->teamOneName, header->teamOne)],
+                          &teamTwo = match.teams[teamKey(header->teamTwoName, header->teamTwo)];
+
+                teamOne.matches       = teamTwo.matches = 1;
+                teamOne.pointsFor     = teamTwo.pointsAgainst = teamOnePoints;
+                teamOne.pointsAgainst = teamTwo.pointsFor     = teamTwoPoints;
+
+                if (teamOnePoints == teamTwoPoints)
+                {
+                    teamOne.draws = teamTwo.draws = 1;
+                }
+                else
+                {
+                    ((teamOnePoints > teamTwoPoints) ? teamOne : teamTwo).wins   = 1;
+                    ((teamOnePoints > teamTwoPoints) ? teamTwo : teamOne).losses = 1;
+                }
+            }
+            break;
+
+            default:
+                break;
+        }
+    }
+
+    match.matches = 1;
+    totals.merge(match);
+}
+
+static void analyzeFile (const std::string &path, Totals &totals)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        totals.invalid++;
+        return;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        totals.invalid++;
+        return;
+    }
+
+    void* base = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        totals.invalid++;
+        return;
+    }
+
+    analyzeTimeline((const char*)base, info.st_size, totals);
+
+    munmap(base, info.st_size);
+}
+
+static void usage (const char* program)
+{
+    fprintf(stderr, "Usage: %s [-j threads] <directory>\n", program);
+    fprintf(stderr, "Recomputes player and team stats from the official match timelines in a directory and prints them as JSON.\n");
+}
+
+int main (int argc, char* argv[])
+{
+    std::string directory;
+    int threadCount = std::thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threadCount = atoi(argv[++i]);
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            directory = argv[i];
+        }
+    }
+
+    if (directory.empty())
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> timelines;
+    findTimelines(directory, timelines);
+
+    if (threadCount < 1)
+    {
+        threadCount = 1;
+    }
+
+    if (threadCount > (int)timelines.size())
+    {
+        threadCount = std::max((int)timelines.size(), 1);
+    }
+
+    // Each worker claims the next timeline that hasn't been processed; small matches and large ones even out that way
+    std::atomic<size_t>      nextTimeline(0);
+    std::vector<Totals>      workerTotals(threadCount);
+    std::vector<std::thread> workers;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.push_back(std::thread([&timelines, &nextTimeline, &workerTotals, i] ()
+        {
+            size_t timeline;
+
+            while ((timeline = nextTimeline++) < timelines.size())
+            {
+                analyzeFile(timelines[timeline], workerTotals[i]);
+            }
+        }));
+    }
+
+    Totals totals;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].join();
+        totals.merge(workerTotals[i]);
+    }
+
+    JsonWriter json(4096);
+
+    json.beginObject()
+            .set("timelines",  (long long)timelines.size())
+            .set("matches",    totals.matches)
+            .set("canceled",   totals.canceled)
+            .set("incomplete", totals.incomplete)
+            .set("invalid",    totals.invalid)
+            .key("players").beginObject();
+
+    for (auto &player : totals.players)
+    {
+        json.key(player.first.c_str()).beginObject()
+                .set("matches",       player.second.matches)
+                .set("captures",      player.second.captures)
+                .set("kills",         player.second.kills)
+                .set("deaths",        player.second.deaths)
+                .set("teamKills",     player.second.teamKills)
+                .set("suicides",      player.second.suicides)
+                .set("secondsPlayed", player.second.secondsPlayed)
+            .endObject();
+    }
+
+    json.endObject()
+        .key("teams").beginObject();
+
+    for (auto &team : totals.teams)
+    {
+        json.key(team.first.c_str()).beginObject()
+                .set("matches",       team.second.matches)
+                .set("wins",          team.second.wins)
+                .set("losses",        team.second.losses)
+                .set("draws",         team.second.draws)
+                .set("pointsFor",     team.second.pointsFor)
+                .set("pointsAgainst", team.second.pointsAgainst)
+            .endObject();
+    }
+
+    json.endObject()
+        .endObject();
+
+    printf("%s\n", json.c_str());
+
+    return 0;
+}
\ No newline at end of file
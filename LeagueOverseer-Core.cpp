@@ -54,23 +54,37 @@ void LeagueOverseer::Init (const char* commandLine)
     Register(bz_eGameStartEvent);
     Register(bz_eGetAutoTeamEvent);
     Register(bz_eGetPlayerMotto);
+    Register(bz_ePlayerDieEvent);
     Register(bz_ePlayerJoinEvent);
     Register(bz_ePlayerPartEvent);
     Register(bz_eRawChatMessageEvent);
     Register(bz_eSlashCommandEvent);
     Register(bz_eTickEvent);
 
-    // Add all of the support slash commands so we can easily remove them in the Cleanup() function
-    SLASH_COMMANDS = {"cancel", "f", "finish", "fm", "lodbg", "leagueoverseer", "los", "o", "offi", "official", "p", "pause", "r", "resume", "showhidden", "spawn", "s", "stats", "timelimit"};
-
     // Register our custom slash commands
-    for (auto command : SLASH_COMMANDS)
-    {
-        bz_registerCustomSlashCommand(command.c_str(), this);
-    }
+    registerSlashCommands();
 
     // Set some default values
     officialMatch = NULL;
+    nextMuteListRefresh = 0;
+    rollCallTimer = 0;
+
+    memset(playerBZIDs, 0, sizeof(playerBZIDs));
+
+    for (double &expiry : pcProtectionExpiry)
+    {
+        expiry = 0;
+    }
+
+    buildFlagTeamTable();
+
+    // Players who were here before we were loaded won't have a join event
+    PlayerListHandle playerList(bz_getPlayerIndexList());
+
+    for (unsigned int i = 0; playerList && i < playerList->size(); i++)
+    {
+        permissionManager.playerJoined(playerList->get(i));
+    }
 
     // Load the configuration data when the plugin is loaded
     CONFIG_PATH = commandLine;
@@ -80,13 +94,7 @@ void LeagueOverseer::Init (const char* commandLine)
     if (pluginSettings.getMapChangePath() != "" && pluginSettings.isRotationalLeague())
     {
         // Open the mapchange.out file to see what map is being used
-        std::ifstream infile;
-        infile.open(pluginSettings.getMapChangePath().c_str());
-        getline(infile, MAP_NAME);
-        infile.close();
-
-        // Remove the '.conf' from the mapchange.out file
-        MAP_NAME = MAP_NAME.substr(0, MAP_NAME.length() - 5);
+        MAP_NAME = ConfigWatcher::readMapName(pluginSettings.getMapChangePath());
 
         logMessage(pluginSettings.getDebugLevel(), "debug", "Current map being played: %s", MAP_NAME.c_str());
     }
@@ -123,15 +131,57 @@ void LeagueOverseer::Init (const char* commandLine)
         logMessage(0, "error", "Team colors could not be detected in LeagueOverseer::Init()");
     }
 
+    // Hand our requests to the relay daemon when there is one so the servers on this host share their connections
+    if (!pluginSettings.getReportRelaySocket().empty() && !reportRelay.connect(pluginSettings.getReportRelaySocket()))
+    {
+        logMessage(0, "warning", "The report relay at %s is not running. Requests will be sent directly until it can be reached.",
+            pluginSettings.getReportRelaySocket().c_str());
+    }
+
     // Set up our UrlQuery objects
-    TeamUrlRepo  = UrlQuery(this, pluginSettings.getTeamNameURL().c_str());
-    MatchUrlRepo = UrlQuery(this, pluginSettings.getMatchReportURL().c_str());
+    TeamUrlRepo  = UrlQuery(this, pluginSettings.getTeamNameURL().c_str(), &reportRelay, &metrics);
+    MatchUrlRepo = UrlQuery(this, pluginSettings.getMatchReportURL().c_str(), &reportRelay, &metrics);
+
+    nextTeamCacheCheck = 0;
 
-    // Request the team name database
     if (pluginSettings.isMottoFetchEnabled())
     {
-        logMessage(pluginSettings.getVerboseLevel(), "debug", "Requesting team name database...");
-        TeamUrlRepo.set("query", "teamNameDump").submit();
+        // Servers on the same host can share a single copy of the team names, which only the elected server downloads
+        if (!pluginSettings.getTeamCacheName().empty() && !teamCache.attach(pluginSettings.getTeamCacheName()))
+        {
+            logMessage(0, "error", "The shared team name cache '%s' could not be opened. This server will fetch its own team names.",
+                pluginSettings.getTeamCacheName().c_str());
+        }
+
+        // Request the team name database
+        if (!teamCache.attached() || (teamCache.isWriter() && teamCache.isStale(pluginSettings.getTeamCacheRefresh() * 60)))
+        {
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Requesting team name database...");
+            TeamUrlRepo.set("query", "teamNameDump").submit();
+        }
+        else
+        {
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Using the team names shared through '%s'", pluginSettings.getTeamCacheName().c_str());
+        }
+    }
+
+    // Start the background worker that archives saved replays
+    if (pluginSettings.isReplayArchiveEnabled())
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Replays will be archived to %s", pluginSettings.getReplayArchivePath().c_str());
+        replayArchiver.start(pluginSettings.getReplayDirectory(), pluginSettings.getReplayArchivePath());
+    }
+
+    // Start the background worker that keeps the replays on disk within their budgets
+    startReplayRetention();
+
+    // Start the background worker that writes our metrics for node_exporter
+    startMetrics();
+
+    // Apply edits to the configuration as soon as they're saved
+    if (!configWatcher.start(CONFIG_PATH, pluginSettings.isRotationalLeague() ? pluginSettings.getMapChangePath() : ""))
+    {
+        logMessage(0, "warning", "Changes to %s will not be noticed. Use '/los reload' after editing it.", CONFIG_PATH.c_str());
     }
 
     // Create a new BZDB variable to easily set the amount of seconds team flags are protected after captures
@@ -143,6 +193,9 @@ void LeagueOverseer::Init (const char* commandLine)
         logMessage(0, "warning", "Invalid value for the PC protection delay. Default value used: %d", PC_PROTECTION_DELAY);
     }
 
+    // Give other plug-ins a valid snapshot even before the first match
+    publishMatchSnapshot(MATCH_STATE_NONE);
+
     // Set a clip field with the full name of the plug-in for other plug-ins to know the exact name of the plug-in
     // since this plug-in has a versioning system; i.e. League Overseer X.Y.Z (r)
     bz_setclipFieldString("LeagueOverseer", Name());
@@ -248,8 +301,22 @@ void LeagueOverseer::Cleanup (void)
    Flush();
 
    // Clean up our custom slash commands
-   for (auto command : SLASH_COMMANDS)
-   {
-       bz_removeCustomSlashCommand(command.c_str());
-   }
+   removeSlashCommands();
+
+   configWatcher.stop();
+   metrics.stop();
+
+   // Don't hold up the server compressing replays; the ones that weren't archived are left in the replay directory and
+   // the match reports that were waiting on them are sent without a replay hash
+   replayArchiver.stop(false);
+   collectArchivedReplays(true);
+
+   replayRetention.stop();
+   collectEvictedReplays();
+
+   // Let another server on this host take over refreshing the team names
+   teamCache.detach();
+
+   // The relay still sends what it already has after we're gone; BZFS sends whatever it didn't get
+   reportRelay.disconnect();
 }
\ No newline at end of file
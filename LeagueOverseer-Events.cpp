@@ -21,10 +21,18 @@ League Overseer
 #include "LeagueOverseer.h"
 #include "LeagueOverseer-Helpers.h"
 
+#include "MatchEvent-Capture.h"
 #include "MatchEvent-Join.h"
+#include "MatchEvent-Kill.h"
+#include "MatchEvent-Part.h"
+#include "MatchEvent-Pause.h"
 
 void LeagueOverseer::Event (bz_EventData *eventData)
 {
+    metrics.eventHandled(eventData->eventType);
+
+    TraceRecorder::Scope eventScope(tracer, getEventName(eventData->eventType));
+
     switch (eventData->eventType)
     {
         case bz_eAllowFlagGrab: // This event is called each time a player attempts to grab a flag
@@ -39,21 +47,25 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (bool)         allow     - Whether or not to allow the flag grab
             //    (double)       eventTime - The server time at which the event occurred (in seconds).
 
-            std::string              flagAbbr          = allowFlagGrabData->flagType;
+            int                      flagID            = allowFlagGrabData->flagID;
             int                      playerID          = allowFlagGrabData->playerID;
 
             if (pluginSettings.isPcProtectionEnabled()) // Is the server configured to protect against Pass Camping
             {
-                // Check if the last capture was within the 'PC_PROTECTION_DELAY' amount of seconds
-                if (LAST_CAP + PC_PROTECTION_DELAY > bz_getCurrentTime())
+                // A flag we haven't seen yet means the world's flags changed, so look them up again
+                if (flagID < 0 || flagID >= (int)flagTeams.size())
                 {
-                    // Check to see if the flag being grabbed belongs to the team that just had their flag captured AND check
-                    // to see if someone not from the victim team grabbed it
-                    if ((getTeamTypeFromFlag(flagAbbr) == CAP_VICTIM_TEAM && bz_getPlayerTeam(playerID) != CAP_VICTIM_TEAM))
-                    {
-                        // Disallow the flag grab if it's being grabbed by an enemy right after a flag capture
-                        allowFlagGrabData->allow = false;
-                    }
+                    buildFlagTeamTable();
+                }
+
+                bz_eTeamType flagTeam = (flagID >= 0 && flagID < (int)flagTeams.size()) ? flagTeams[flagID] : eNoTeam;
+
+                // Check to see if the flag being grabbed belongs to a team that had their flag captured within the last
+                // 'PC_PROTECTION_DELAY' seconds AND check to see if someone not from that team grabbed it
+                if (flagTeam != eNoTeam && pcProtectionExpiry[flagTeam] > allowFlagGrabData->eventTime && bz_getPlayerTeam(playerID) != flagTeam)
+                {
+                    // Disallow the flag grab if it's being grabbed by an enemy right after a flag capture
+                    allowFlagGrabData->allow = false;
                 }
             }
         }
@@ -79,8 +91,12 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                 allowSpawnData->handled = true;
                 allowSpawnData->allow   = false;
 
-                // Send the player a message, either default or custom based on 'SPAWN_MSG_ENABLED'
-                sendPluginMessage(playerID, pluginSettings.isSpawnMessageEnabled(), pluginSettings.getNoSpawnMessage(), SPAWN);
+                // Send the player a message, either default or custom based on 'SPAWN_MSG_ENABLED', unless they've just been
+                // sent it and are mashing the spawn key
+                if (rateLimiter.take(playerID, RATE_LIMIT_NOTICE, allowSpawnData->eventTime))
+                {
+                    sendPluginMessage(playerID, pluginSettings.isSpawnMessageEnabled(), pluginSettings.getNoSpawnMessage(), SPAWN);
+                }
             }
         }
         break;
@@ -116,20 +132,26 @@ void LeagueOverseer::Event (bz_EventData *eventData)
 
         case bz_eCaptureEvent: // This event is called each time a team's flag has been captured
         {
+            bz_CTFCaptureEventData_V1* captureData = (bz_CTFCaptureEventData_V1*)eventData;
+
+            // Data
+            // ---
+            //    (bz_eTeamType)  teamCapped    - The team whose flag was captured.
+            //    (bz_eTeamType)  teamCapping   - The team who did the capturing.
+            //    (int)           playerCapping - The player who captured the flag.
+            //    (float[3])      pos           - The world position(X,Y,Z) where the flag has been captured
+            //    (float)         rot           - The rotational orientation of the capturing player
+            //    (double)        eventTime     - This value is the local server time of the event.
+
+            // Every capture is marked in the replay index, fun match or not
+            if (RECORDING)
+            {
+                replayIndex.record(ReplayIndex::CAPTURE, captureData->eventTime, getBZIDByID(captureData->playerCapping), "", captureData->teamCapping);
+            }
+
             // We only need to keep track of the store if it's an official match
             if (isOfficialMatch())
             {
-                bz_CTFCaptureEventData_V1* captureData = (bz_CTFCaptureEventData_V1*)eventData;
-
-                // Data
-                // ---
-                //    (bz_eTeamType)  teamCapped    - The team whose flag was captured.
-                //    (bz_eTeamType)  teamCapping   - The team who did the capturing.
-                //    (int)           playerCapping - The player who captured the flag.
-                //    (float[3])      pos           - The world position(X,Y,Z) where the flag has been captured
-                //    (float)         rot           - The rotational orientation of the capturing player
-                //    (double)        eventTime     - This value is the local server time of the event.
-
                 (captureData->teamCapping == TEAM_ONE) ? officialMatch->teamOnePoints++ : officialMatch->teamTwoPoints++;
 
                 // Log the information about the current score to the logs at the verbose level
@@ -138,21 +160,56 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                     formatTeam(TEAM_ONE).c_str(), officialMatch->teamOnePoints,
                     formatTeam(TEAM_TWO).c_str(), officialMatch->teamTwoPoints);
 
-                CAP_VICTIM_TEAM = captureData->teamCapped;
-                CAP_WINNER_TEAM = captureData->teamCapping;
-                LAST_CAP        = captureData->eventTime;
+                // Every team keeps its own protection so back to back captures of different flags are all covered
+                if (captureData->teamCapped > eRogueTeam && captureData->teamCapped <= ePurpleTeam)
+                {
+                    pcProtectionExpiry[captureData->teamCapped] = captureData->eventTime + PC_PROTECTION_DELAY;
+                }
 
                 // Create a player record of the person who captured the flag
-                std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(captureData->playerCapping));
+                PlayerRecordHandle playerData(bz_getPlayerByIndex(captureData->playerCapping));
+
+                eventJson.reset();
+                eventJson.beginObject()
+                             .key("event").beginObject()
+                                 .set("type",  "capture")
+                                 .set("color", formatTeam(captureData->teamCapped))
+                             .endObject()
+                         .endObject();
 
                 // Create a MatchEvent with the information relating to the capture
+                char matchTime[MATCH_CLOCK_BUFFER_SIZE];
+
                 MatchEvent capEvent(playerData->playerID, std::string(playerData->bzID.c_str()),
                                      std::string(playerData->callsign.c_str()) + " captured the " + formatTeam(captureData->teamCapped) + " flag",
-                                     "{\"event\": {\"type\": \"capture\", \"color\": \"" + formatTeam(captureData->teamCapped) + "\"}}",
-                                     getMatchTime());
+                                     eventJson.str(),
+                                     getMatchTime(matchTime, sizeof(matchTime)));
 
                 // Push the MatchEvent to the matchEvents vector stored in the officialMatch struct
                 officialMatch->matchEvents.push_back(capEvent);
+
+                CaptureMatchEvent captureEvent = CaptureMatchEvent().setTime(capEvent.match_time)
+                                                                    .setBZID(capEvent.bzID)
+                                                                    .setCallsign(playerData->callsign.c_str())
+                                                                    .setTeamID(captureData->teamCapping)
+                                                                    .setCappedTeamID(captureData->teamCapped)
+                                                                    .setScore(officialMatch->teamOnePoints, officialMatch->teamTwoPoints);
+
+                officialMatch->summary.recordCapture(capEvent.match_time, capEvent.bzID, playerData->callsign.c_str(),
+                                                     officialMatch->teamOnePoints, officialMatch->teamTwoPoints, captureEvent);
+
+                matchTimeline.recordEvent(captureData->eventTime, captureEvent);
+
+                publishMatchSnapshot();
+
+                if (eventBus.hasSubscribers())
+                {
+                    LosBusEvent busEvent = createBusEvent(LOS_EVENT_CAPTURE, captureData->playerCapping);
+                    busEvent.team      = captureData->teamCapping;
+                    busEvent.otherTeam = captureData->teamCapped;
+
+                    eventBus.publish(busEvent);
+                }
             }
         }
         break;
@@ -161,13 +218,16 @@ void LeagueOverseer::Event (bz_EventData *eventData)
         {
             logMessage(pluginSettings.getVerboseLevel(), "debug", "A match has ended.");
 
-            // Grant the "poll" perm when the match is over
-            grantPermToAll("poll");
+            timers.cancel(rollCallTimer);
+            rollCallTimer = 0;
+
+            // Give back the "poll" perm to the players we took it from when the match is over
+            permissionManager.setRevoked(0);
 
             // Get the current standard UTC time
-            bz_Time standardTime;
-            bz_getUTCtime(&standardTime);
+            bz_Time standardTime = getCurrentUTCTime();
             std::string recordingFileName;
+            int         archiveJobID = 0;
 
             // Only save the recording buffer if we actually started recording when the match started
             if (RECORDING)
@@ -212,13 +272,36 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                 logMessage(pluginSettings.getVerboseLevel(), "debug", "Replay file will be named: %s", recordingFileName.c_str());
 
                 // Save the recording buffer and stop recording
-                bz_saveRecBuf(recordingFileName.c_str(), 0);
-                bz_stopRecBuf();
+                {
+                    TraceRecorder::Scope scope(tracer, "bz_saveRecBuf");
+                    bz_saveRecBuf(recordingFileName.c_str(), 0);
+                    bz_stopRecBuf();
+                }
                 logMessage(pluginSettings.getVerboseLevel(), "debug", "Replay file has been saved and recording has stopped.");
 
                 // We're no longer recording, so set the boolean and announce to players that the file has been saved
                 RECORDING = false;
                 bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Match saved as: %s", recordingFileName.c_str());
+
+                // The index of the events that happened during the recording is saved next to the replay
+                std::string index = replayIndex.serialize(recordingFileName);
+                replayIndex.clear();
+
+                // Compressing and hashing a replay takes a while, so it's handed off to a background thread along
+                // with its index
+                if (replayArchiver.running())
+                {
+                    archiveJobID = replayArchiver.queue(recordingFileName, standardTime.year, standardTime.month, standardTime.day, index);
+                }
+                else
+                {
+                    saveReplayIndex(recordingFileName, index);
+
+                    if (replayRetention.running())
+                    {
+                        replayRetention.track(pluginSettings.getReplayDirectory() + "/" + recordingFileName);
+                    }
+                }
             }
 
             if (pluginSettings.isMatchReportEnabled())
@@ -247,9 +330,8 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                 {
                     // This was an official match, so let's report it
 
-                    // Format the date to -> year-month-day hour:minute:second
-                    char matchDate[20];
-                    sprintf(matchDate, "%02d-%02d-%02d %02d:%02d:%02d", standardTime.year, standardTime.month, standardTime.day, standardTime.hour, standardTime.minute, standardTime.second);
+                    // The date formatted as year-month-day hour:minute:second
+                    const char* matchDate = getCurrentTimeStamp();
 
                     // Keep references to values for quick reference
                     std::string teamOnePointsFinal = std::to_string(officialMatch->teamOnePoints);
@@ -286,22 +368,62 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                     // Finish prettifying the server logs
                     bz_debugMessagef(0, "Match Data :: -----------------------------");
                     bz_debugMessagef(0, "Match Data :: End of Match Report");
-                    logMessage(pluginSettings.getDebugLevel(), "debug", "Reporting match data...");
                     bz_sendTextMessage(BZ_SERVER, BZ_ALLUSERS, "Reporting match...");
 
-                    // Send off the match
-                    MatchUrlRepo.submit();
+                    if (archiveJobID)
+                    {
+                        // Hold on to the report until the replay has been archived so its hash and size can be included
+                        pendingMatchReports[archiveJobID] = MatchUrlRepo;
+                        MatchUrlRepo.reset();
+                    }
+                    else
+                    {
+                        logMessage(pluginSettings.getDebugLevel(), "debug", "Reporting match data...");
+
+                        // Send off the match
+                        MatchUrlRepo.submit();
 
-                    // Send the match data to the league website
-                    MATCH_INFO_SENT = true;
+                        // Send the match data to the league website
+                        MATCH_INFO_SENT = true;
+                    }
                 }
             }
 
+            // The timeline is complete once we know how the match ended
+            if (matchTimeline.isOpen())
+            {
+                bool canceled = isOfficialMatch() && officialMatch->canceled;
+
+                matchTimeline.record(TIMELINE_MATCH_END, bz_getCurrentTime(), "", "", TEAM_ONE, TEAM_TWO,
+                                     (isOfficialMatch()) ? officialMatch->teamOnePoints : 0, (isOfficialMatch()) ? officialMatch->teamTwoPoints : 0,
+                                     (canceled) ? MATCH_TIMELINE_CANCELED : 0);
+                matchTimeline.close();
+            }
+
+            metrics.matchEnded(isOfficialMatch(), isOfficialMatch() && officialMatch->canceled);
+
+            // Let the subscribers know how the match ended before we forget about it
+            if (eventBus.hasSubscribers())
+            {
+                bool canceled = isOfficialMatch() && officialMatch->canceled;
+
+                LosBusEvent busEvent = createBusEvent((canceled) ? LOS_EVENT_MATCH_CANCEL : LOS_EVENT_MATCH_END);
+
+                if (canceled)
+                {
+                    snprintf(busEvent.detail, sizeof(busEvent.detail), "%s", officialMatch->cancelationReason.c_str());
+                }
+
+                eventBus.publish(busEvent);
+            }
+
             // We're done with the struct, so make it NULL until the next official match
             officialMatch = NULL;
 
+            publishMatchSnapshot(MATCH_STATE_NONE);
+
             // Empty our list of players since we don't need a history
-            activePlayerList.clear();
+            clearActivePlayers();
         }
         break;
 
@@ -314,31 +436,63 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (bz_ApiString) actionBy  - The callsign of whoever triggered the event. By default, it's "SERVER"
             //    (double)       eventTime - The server time the event occurred (in seconds).
 
-            // Get the current UTC time
-            MATCH_PAUSED = time(NULL);
+            matchClock.pause(gamePauseData->eventTime);
+
+            // The roll call happens at a point on the match clock, which doesn't move while we're paused
+            timers.cancel(rollCallTimer);
+            rollCallTimer = 0;
+
+            // The clock is stopped so the time remaining won't change while we're handling the pause
+            char matchTime[MATCH_CLOCK_BUFFER_SIZE];
+            getMatchTime(matchTime, sizeof(matchTime));
+
+            if (RECORDING)
+            {
+                replayIndex.record(ReplayIndex::PAUSE, gamePauseData->eventTime, getBZIDByCallsign(gamePauseData->actionBy.c_str()));
+            }
 
             // We've paused an official match, so we need to delay the approxTimeProgress in order to calculate the roll call time properly
             if (isOfficialMatch())
             {
-                // Grant the "poll" perm while a match is paused
-                grantPermToAll("poll");
+                // Give back the "poll" perm while a match is paused
+                permissionManager.setRevoked(0);
 
                 // Send the messages
-                bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "    with %s remaining.", getMatchTime().c_str());
-                logMessage(pluginSettings.getVerboseLevel(), "debug", "Match paused at %s by %s.", getMatchTime().c_str(), gamePauseData->actionBy.c_str());
+                bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "    with %s remaining.", matchTime);
+                logMessage(pluginSettings.getVerboseLevel(), "debug", "Match paused at %s by %s.", matchTime, gamePauseData->actionBy.c_str());
 
                 // Create a player record of the person who captured the flag
-                std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByCallsign(gamePauseData->actionBy.c_str()));
+                PlayerRecordHandle playerData(bz_getPlayerByCallsign(gamePauseData->actionBy.c_str()));
+
+                eventJson.reset();
+                eventJson.beginObject()
+                             .key("event").beginObject()
+                                 .set("type", "pause")
+                             .endObject()
+                         .endObject();
 
                 // Create a MatchEvent with the information relating to the capture
                 MatchEvent pauseEvent(playerData->playerID, std::string(playerData->bzID.c_str()),
-                                     std::string(playerData->callsign.c_str()) + " paused the match at " + getMatchTime(),
-                                     "{\"event\": {\"type\": \"pause\"}}",
-                                     getMatchTime());
+                                     std::string(playerData->callsign.c_str()) + " paused the match at " + matchTime,
+                                     eventJson.str(),
+                                     matchTime);
 
                 // Push the MatchEvent to the matchEvents vector stored in the officialMatch struct
                 officialMatch->matchEvents.push_back(pauseEvent);
+
+                PauseMatchEvent pause = PauseMatchEvent().setPaused()
+                                                         .setTime(matchTime)
+                                                         .setBZID(pauseEvent.bzID)
+                                                         .setCallsign(playerData->callsign.c_str());
+
+                officialMatch->summary.recordPause(pauseEvent.match_time, gamePauseData->eventTime, pause);
+
+                // Nothing is going to happen for a while so get what we have onto the disk
+                matchTimeline.recordEvent(gamePauseData->eventTime, pause);
+                matchTimeline.flush();
             }
+
+            publishMatchSnapshot(MATCH_STATE_PAUSED);
         }
         break;
 
@@ -352,41 +506,56 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (double)       eventTime - The server time the event occurred (in seconds).
 
 
-            // Get the current UTC time
-            time_t now = time(NULL);
-
-            // Do the math to determine how long the match was paused
-            double timePaused = difftime(now, MATCH_PAUSED);
+            if (RECORDING)
+            {
+                replayIndex.record(ReplayIndex::RESUME, gameResumeData->eventTime, getBZIDByCallsign(gameResumeData->actionBy.c_str()));
+            }
 
-            // Create a temporary variable to store and manipulate the match start time
-            struct tm modMatchStart = *localtime(&MATCH_START);
+            // Start the clock again; the time spent paused doesn't count towards the match's progress
+            double timePaused = matchClock.resume(gameResumeData->eventTime);
+            scheduleRollCall();
 
-            // Manipulate the time by adding the amount of seconds the match was paused in order to be able to accurately
-            // calculate the amount of time remaining with LeagueOverseer::getMatchTime()
-            modMatchStart.tm_sec += timePaused;
+            char matchTime[MATCH_CLOCK_BUFFER_SIZE];
+            getMatchTime(matchTime, sizeof(matchTime));
 
-            // Save the manipulated match start time
-            MATCH_START = mktime(&modMatchStart);
-            logMessage(pluginSettings.getVerboseLevel(), "debug", "Match paused for %.f seconds. Match continuing at %s.", timePaused, getMatchTime().c_str());
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Match paused for %.1f seconds. Match continuing at %s.", timePaused, matchTime);
 
             // We've resumed an official match, so we need to properly edit the start time so we can calculate the roll call
             if (isOfficialMatch())
             {
                 // Revoke the "poll" perm while a match is active
-                revokePermFromAll("poll");
+                permissionManager.setRevoked(MANAGED_PERM_POLL);
 
                 // Create a player record of the person who captured the flag
-                std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByCallsign(gameResumeData->actionBy.c_str()));
+                PlayerRecordHandle playerData(bz_getPlayerByCallsign(gameResumeData->actionBy.c_str()));
+
+                eventJson.reset();
+                eventJson.beginObject()
+                             .key("event").beginObject()
+                                 .set("type", "resume")
+                             .endObject()
+                         .endObject();
 
                 // Create a MatchEvent with the information relating to the capture
                 MatchEvent resumeEvent(playerData->playerID, std::string(playerData->bzID.c_str()),
                                      std::string(playerData->callsign.c_str()) + " resumed the match",
-                                     "{\"event\": {\"type\": \"resume\"}}",
-                                     getMatchTime());
+                                     eventJson.str(),
+                                     matchTime);
 
                 // Push the MatchEvent to the matchEvents vector stored in the officialMatch struct
                 officialMatch->matchEvents.push_back(resumeEvent);
+
+                PauseMatchEvent resume = PauseMatchEvent().setResumed()
+                                                          .setTime(matchTime)
+                                                          .setBZID(resumeEvent.bzID)
+                                                          .setCallsign(playerData->callsign.c_str());
+
+                officialMatch->summary.recordResume(resumeEvent.match_time, gameResumeData->eventTime, resume);
+
+                matchTimeline.recordEvent(gameResumeData->eventTime, resume);
             }
+
+            publishMatchSnapshot(MATCH_STATE_RUNNING);
         }
         break;
 
@@ -395,10 +564,27 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             logMessage(pluginSettings.getVerboseLevel(), "debug", "A match has started");
 
             // Empty our list of players since we don't need a history
-            activePlayerList.clear();
+            clearActivePlayers();
+
+            // Start the match with fresh flag information and without any protection left over from before the match
+            buildFlagTeamTable();
+
+            for (double &expiry : pcProtectionExpiry)
+            {
+                expiry = 0;
+            }
 
             // We started recording a match, so save the status
-            RECORDING = bz_startRecBuf();
+            {
+                TraceRecorder::Scope scope(tracer, "bz_startRecBuf");
+                RECORDING = bz_startRecBuf();
+            }
+
+            // Replay index offsets are measured from the moment the recording started
+            if (RECORDING)
+            {
+                replayIndex.start(bz_getCurrentTime());
+            }
 
             // We want to notify the logs if we couldn't start recording just in case an issue were to occur and the server
             // owner needs to check to see if players were lying about there no replay
@@ -415,14 +601,57 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             if (isOfficialMatch())
             {
                 // Revoke the "poll" perm while a match is active
-                revokePermFromAll("poll");
+                {
+                    TraceRecorder::Scope scope(tracer, "revoke_permissions");
+                    permissionManager.setRevoked(MANAGED_PERM_POLL);
+                }
 
                 // Reset scores in case Caps happened during countdown delay.
                 officialMatch->teamOnePoints = officialMatch->teamTwoPoints = 0;
                 officialMatch->duration = bz_getTimeLimit();
+
+                if (!pluginSettings.getTimelineDirectory().empty())
+                {
+                    TraceRecorder::Scope scope(tracer, "open_timeline");
+
+                    std::string timelinePath = pluginSettings.getTimelineDirectory() + "/offi-" + getCurrentFileTimeStamp() + ".timeline";
+
+                    if (!matchTimeline.open(timelinePath, bz_getCurrentTime(), time(NULL), TEAM_ONE, TEAM_TWO))
+                    {
+                        logMessage(0, "error", "The match timeline could not be created at %s", timelinePath.c_str());
+                    }
+                    else
+                    {
+                        // Players who were already on a team when the match started are recorded as joining at the
+                        // start so tools can tell who played the whole match
+                        PlayerListHandle playerList(bz_getPlayerIndexList());
+
+                        for (unsigned int i = 0; playerList && i < playerList->size(); i++)
+                        {
+                            PlayerRecordHandle playerRecord(bz_getPlayerByIndex(playerList->get(i)));
+
+                            if (playerRecord && playerRecord->team != eObservers)
+                            {
+                                JoinMatchEvent joinEvent = JoinMatchEvent().setCallsign(playerRecord->callsign.c_str())
+                                                                           .setBZID(playerRecord->bzID.c_str())
+                                                                           .setTeamID(playerRecord->team);
+
+                                matchTimeline.recordEvent(bz_getCurrentTime(), joinEvent);
+                            }
+                        }
+                    }
+                }
             }
 
-            MATCH_START = time(NULL);
+            matchClock.start(bz_getCurrentTime(), (isOfficialMatch()) ? officialMatch->duration : bz_getTimeLimit());
+            scheduleRollCall();
+
+            publishMatchSnapshot(MATCH_STATE_RUNNING);
+
+            if (eventBus.hasSubscribers())
+            {
+                eventBus.publish(createBusEvent(LOS_EVENT_MATCH_START));
+            }
         }
         break;
 
@@ -443,7 +672,7 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (double)        eventTime - This value is the local server time of the event.
 
             int playerID = autoTeamData->playerID;
-            std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+            PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
             // Only force new players to observer if a match is in progress
             if (isMatchInProgress())
@@ -475,6 +704,45 @@ void LeagueOverseer::Event (bz_EventData *eventData)
         }
         break;
 
+        case bz_ePlayerDieEvent: // This event is called each time a tank is killed
+        {
+            bz_PlayerDieEventData_V1* dieData = (bz_PlayerDieEventData_V1*)eventData;
+
+            // Data
+            // ---
+            //    (int)           playerID       - ID of the player who was killed.
+            //    (bz_eTeamType)  team           - The team the killed player was on.
+            //    (int)           killerID       - The owner of the shot that killed the player, or BZ_SERVER for server side kills
+            //    (bz_eTeamType)  killerTeam     - The team the owner of the shot was on.
+            //    (bz_ApiString)  flagKilledWith - The flag name the owner of the shot had when the shot was fired.
+            //    (int)           shotID         - The shot ID that killed the player, if the player was not killed by the server.
+            //    (double)        eventTime      - The server time at which the event occurred (in seconds).
+
+            // Kills are only tracked for the replay index and the match timeline
+            if (RECORDING || matchTimeline.isOpen())
+            {
+                std::string victimBZID = getBZIDByID(dieData->playerID),
+                            killerBZID = (dieData->killerID >= 0) ? getBZIDByID(dieData->killerID) : "";
+
+                if (RECORDING)
+                {
+                    replayIndex.record(ReplayIndex::KILL, dieData->eventTime, victimBZID, killerBZID, dieData->team);
+                }
+
+                if (matchTimeline.isOpen())
+                {
+                    KillMatchEvent killEvent = KillMatchEvent().setVictim(victimBZID)
+                                                               .setKiller(killerBZID)
+                                                               .setVictimTeamID(dieData->team)
+                                                               .setKillerTeamID(dieData->killerTeam)
+                                                               .setShotID(dieData->shotID);
+
+                    matchTimeline.recordEvent(dieData->eventTime, killEvent);
+                }
+            }
+        }
+        break;
+
         case bz_ePlayerJoinEvent: // This event is called each time a player joins the game
         {
             bz_PlayerJoinPartEventData_V1* joinData = (bz_PlayerJoinPartEventData_V1*)eventData;
@@ -486,15 +754,18 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (double)                eventTime - Time of event.
 
             int playerID = joinData->playerID;
-            std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+            PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
             setLeagueMember(playerID);
+            playerBZIDs[playerID] = (playerData->verified) ? MuteList::toBZID(playerData->bzID.c_str()) : 0;
             storePlayerInfo(playerID, playerData->bzID.c_str(), playerData->callsign.c_str());
+            permissionManager.playerJoined(playerID);
 
             JoinMatchEvent joinEvent = JoinMatchEvent().setCallsign(playerData->callsign.c_str())
                                                        .setVerified(playerData->verified)
                                                        .setIpAddress(playerData->ipAddress.c_str())
                                                        .setBZID(playerData->bzID.c_str())
+                                                       .setTeamID(playerData->team)
                                                        .save();
 
             // Only notify a player if they exist, have joined the observer team, and there is a match in progress
@@ -504,6 +775,22 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                                     ((isOfficialMatch()) ? "an official" : "a fun"));
             }
 
+            matchTimeline.recordEvent(joinData->eventTime, joinEvent);
+
+            // A player joining a team after the roll call of an official match is substituting in
+            if (isOfficialMatchInProgress() && !officialMatch->matchParticipants.empty() && playerData->team != eObservers)
+            {
+                replayIndex.record(ReplayIndex::SUB_IN, joinData->eventTime, playerData->bzID.c_str(), "", playerData->team);
+
+                if (eventBus.hasSubscribers())
+                {
+                    LosBusEvent busEvent = createBusEvent(LOS_EVENT_SUBSTITUTE, playerID);
+                    busEvent.success = true;
+
+                    eventBus.publish(busEvent);
+                }
+            }
+
             if (pluginSettings.isMottoFetchEnabled())
             {
                 // Only send a URL job if the user is verified
@@ -527,22 +814,44 @@ void LeagueOverseer::Event (bz_EventData *eventData)
             //    (double)                eventTime - Time of event.
 
             int playerID = partData->playerID;
-            std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+            PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
             removePlayerInfo(partData->record->bzID.c_str(), partData->record->callsign.c_str());
 
-            // Only keep track of the parting player if they are a league member and there is a match in progress
-            if (isLeagueMember(playerID) && isMatchInProgress())
+            // Don't keep sending output to a slot that someone else may take
+            queuedMessages.erase(playerID);
+            playerBZIDs[playerID] = 0;
+            rateLimiter.reset(playerID);
+            permissionManager.playerLeft(playerID);
+
+            if (matchTimeline.isOpen())
+            {
+                PartMatchEvent partEvent = PartMatchEvent().setBZID(partData->record->bzID.c_str())
+                                                           .setTeamID(partData->record->team);
+
+                matchTimeline.recordEvent(partData->eventTime, partEvent);
+            }
+
+            // A player leaving a team after the roll call of an official match is substituting out
+            if (isOfficialMatchInProgress() && !officialMatch->matchParticipants.empty() && partData->record->team != eObservers)
             {
-                if (!playerAlreadyJoined(playerData->bzID.c_str()))
+                replayIndex.record(ReplayIndex::SUB_OUT, partData->eventTime, partData->record->bzID.c_str(), "", partData->record->team);
+
+                if (eventBus.hasSubscribers())
                 {
-                    // Create a record for the player who just left
-                    Player partingPlayer(playerData->bzID.c_str(), playerData->team, bz_getCurrentTime());
+                    LosBusEvent busEvent = createBusEvent(LOS_EVENT_SUBSTITUTE, playerID);
+                    busEvent.team = partData->record->team;
+                    snprintf(busEvent.bzID, sizeof(busEvent.bzID), "%s", partData->record->bzID.c_str());
 
-                    // Push the record to our vector
-                    activePlayerList.push_back(partingPlayer);
+                    eventBus.publish(busEvent);
                 }
             }
+
+            // Only keep track of the parting player if they are a league member and there is a match in progress
+            if (isLeagueMember(playerID) && isMatchInProgress())
+            {
+                rememberActivePlayer(playerData->bzID.c_str(), playerData->team);
+            }
         }
         break;
 
@@ -570,43 +879,33 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                 break;
             }
 
-            // A non-league player is attempting to talk
-            if (!isLeagueMember(playerID))
+            // Players muted by the league can't talk at all; almost every other player is let through by the filter alone
+            if (muteList.isMuted(playerBZIDs[playerID]))
             {
-                if (pluginSettings.isAllowLimitedChat()) // Are non-league members allowed limited talking functionality
+                chatData->message = "";
+                metrics.increment(METRIC_CHAT_REJECTED_MUTED);
+
+                if (rateLimiter.take(playerID, RATE_LIMIT_NOTICE, chatData->eventTime))
                 {
-                    if (isMatchInProgress()) // A match is progress
-                    {
-                        if (bz_getPlayerTeam(playerID) == eObservers) // Only consider allowing non-league members to talk if they are in the observer team
-                        {
-                            // Only allow non-league members to talk if they're talking to the observer team chat or private messaging a player in the observer team
-                            // this precaution is so non-league players do not private message players participating in a match, do not message an admin who may
-                            // playing a match, and do not send messages to public chat to avoid match disturbances
-                            if (target != eObservers || bz_getPlayerTeam(recipient) != eObservers)
-                            {
-                                chatData->message = ""; // We set the message to nothing so they won't send thing anything
-                                sendPluginMessage(playerID, pluginSettings.isTalkMessageEnabled(), pluginSettings.getNoTalkMessage(), CHAT);
-                            }
-                        }
-                        else // If they aren't in the observer team during a match, don't let them talk
-                        {
-                            chatData->message = "";
-                            sendPluginMessage(playerID, pluginSettings.isTalkMessageEnabled(), pluginSettings.getNoTalkMessage(), CHAT);
-                        }
-                    }
-                    else // A match is not in progress
-                    {
-                        if (target != eAdministrators)
-                        {
-                            chatData->message = "";
-                            sendPluginMessage(playerID, pluginSettings.isTalkMessageEnabled(), pluginSettings.getNoTalkMessage(), CHAT);
-                        }
-                    }
+                    bz_sendTextMessage(BZ_SERVER, playerID, "You have been muted by the league.");
                 }
-                else // Non-league members are not allowed limited talk functionality
+                break;
+            }
+
+            // League members can always talk, so only look up the teams involved for everyone else
+            if (isLeagueMember(playerID))
+            {
+                break;
+            }
+
+            if (!chatPolicy.allows(bz_getPlayerTeam(playerID), target, bz_getPlayerTeam(recipient)))
+            {
+                chatData->message = ""; // We set the message to nothing so they won't send thing anything
+                metrics.increment(METRIC_CHAT_REJECTED_POLICY);
+
+                if (rateLimiter.take(playerID, RATE_LIMIT_NOTICE, chatData->eventTime))
                 {
-                    chatData->message = "";
-                    sendPluginMessage(playerID, pluginSettings.isTalkMessageEnabled(), pluginSettings.getNoTalkMessage(), CHAT); // Send them a message
+                    sendPluginMessage(playerID, pluginSettings.isTalkMessageEnabled(), noTalkMessage, CHAT);
                 }
             }
         }
@@ -624,39 +923,82 @@ void LeagueOverseer::Event (bz_EventData *eventData)
 
             // Store the information in variables for quick reference
             int         playerID = slashCommandData->from;
-            std::string command  = slashCommandData->message.c_str();
+            const char* command  = slashCommandData->message.c_str();
 
             // Because players have quick keys and players of habit, send them a notification in the case they
-            // use a deprecated slash command
-            if (strncmp("/gameover", command.c_str(), 9) == 0)
+            // use a deprecated slash command. The longer prefixes come first, and the first letter of the command is
+            // compared before anything else so most commands are ruled out without a single string comparison.
+            static const struct
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/gameover' is disabled, please use /finish or /cancel instead **");
+                const char* prefix;
+                size_t      length;
+                bool        officialOnly;   // Only deprecated during official matches
+                const char* notice;
             }
-            else if (strncmp("/countdown cancel", command.c_str(), 17) == 0)
+            deprecatedCommands[] = {
+                { "/gameover",         9,  false, "** '/gameover' is disabled, please use /finish or /cancel instead **" },
+                { "/countdown cancel", 17, false, "** '/countdown cancel' is disabled, please use /cancel instead **" },
+                { "/countdown pause",  16, false, "** '/countdown pause' is disabled, please use /pause instead **" },
+                { "/countdown resume", 17, false, "** '/countdown resume' is disabled, please use /resume instead **" },
+                { "/countdown",        10, false, "** '/countdown TIME' is disabled, please use /official or /fm instead **" },
+                { "/poll",             5,  true,  "** '/poll' is disabled during official matches. Please /pause the match in order to start a poll. **" }
+            };
+
+            for (const auto &deprecated : deprecatedCommands)
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/countdown cancel' is disabled, please use /cancel instead **");
+                if (deprecated.prefix[1] == command[1] && strncmp(deprecated.prefix, command, deprecated.length) == 0)
+                {
+                    if (!deprecated.officialOnly || isOfficialMatchInProgress())
+                    {
+                        bz_sendTextMessage(BZ_SERVER, playerID, deprecated.notice);
+                    }
+
+                    break;
+                }
             }
-            else if (strncmp("/countdown pause", command.c_str(), 16) == 0)
+        }
+        break;
+
+        case bz_eTickEvent: // This event is called once for each BZFS main loop
+        {
+            timers.advance(bz_getCurrentTime());
+
+            if (!queuedMessages.empty())
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/countdown pause' is disabled, please use /pause instead **");
+                sendQueuedMessages();
             }
-            else if (strncmp("/countdown resume", command.c_str(), 17) == 0)
+
+            collectArchivedReplays();
+            collectEvictedReplays();
+
+            if (configWatcher.configChanged())
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/countdown resume' is disabled, please use /resume instead **");
+                reloadConfiguration();
             }
-            else if (strncmp("/countdown", command.c_str(), 10) == 0)
+
+            std::string mapName;
+
+            if (configWatcher.mapChanged(mapName))
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/countdown TIME' is disabled, please use /official or /fm instead **");
+                MAP_NAME = mapName;
+                logMessage(pluginSettings.getDebugLevel(), "debug", "Current map being played: %s", MAP_NAME.c_str());
             }
-            else if (strncmp("/poll", command.c_str(), 5) == 0 && isOfficialMatchInProgress())
+
+            if (teamCache.attached())
             {
-                bz_sendTextMessage(BZ_SERVER, playerID, "** '/poll' is disabled during official matches. Please /pause the match in order to start a poll. **");
+                checkTeamCache();
+            }
+
+            if (reportRelay.enabled())
+            {
+                reportRelay.poll();
+            }
+
+            if (pluginSettings.isMuteListEnabled())
+            {
+                requestMuteList();
             }
-        }
-        break;
 
-        case bz_eTickEvent: // This event is called once for each BZFS main loop
-        {
             // Get the total number of tanks playing
             int totaltanks = bz_getTeamCount(eRedTeam) + bz_getTeamCount(eGreenTeam) + bz_getTeamCount(eBlueTeam) + bz_getTeamCount(ePurpleTeam);
 
@@ -673,7 +1015,7 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                 // If we have players recorded and there's no one around, empty the list
                 if (!activePlayerList.empty())
                 {
-                    activePlayerList.clear();
+                    clearActivePlayers();
                 }
 
                 // If there is a countdown active an no tanks are playing, then cancel it
@@ -683,96 +1025,6 @@ void LeagueOverseer::Event (bz_EventData *eventData)
                     logMessage(pluginSettings.getVerboseLevel(), "debug", "Game ended because no players were found playing with an active countdown.");
                 }
             }
-
-            // Let's get the roll call only if there is an official match
-            if (isOfficialMatch())
-            {
-                // Check if the start time is not negative since our default value for the approxTimeProgress is -1. Also check
-                // if it's time to do a roll call, which is defined as 90 seconds after the start of the match by default,
-                // and make sure we don't have any match participants recorded and the match isn't paused
-                if (getMatchProgress() > officialMatch->matchRollCall && officialMatch->matchParticipants.empty() &&
-                    !bz_isCountDownPaused() && !bz_isCountDownInProgress())
-                {
-                    logMessage(pluginSettings.getVerboseLevel(), "debug", "Processing roll call...");
-
-                    std::shared_ptr<bz_APIIntList> playerList(bz_getPlayerIndexList());
-                    bool invalidateRollcall, teamOneError, teamTwoError;
-                    std::string teamOneMotto, teamTwoMotto;
-
-                    invalidateRollcall = teamOneError = teamTwoError = false;
-                    teamOneMotto = teamTwoMotto = "";
-
-                    // We can't do a roll call if the player list wasn't created
-                    if (!playerList)
-                    {
-                        logMessage(pluginSettings.getVerboseLevel(), "error", "Failure to create player list for roll call.");
-                        return;
-                    }
-
-                    for (unsigned int i = 0; i < playerList->size(); i++)
-                    {
-                        std::shared_ptr<bz_BasePlayerRecord> playerRecord(bz_getPlayerByIndex(playerList->get(i)));
-
-                        if (playerRecord && isLeagueMember(playerRecord->playerID) && bz_getPlayerTeam(playerList->get(i)) != eObservers) // If player is not an observer
-                        {
-                            MatchParticipant currentPlayer(playerRecord->bzID.c_str(), playerRecord->callsign.c_str(),
-                                                           playerRecord->ipAddress.c_str(), teamMottos[playerRecord->bzID.c_str()],
-                                                           playerRecord->team);
-
-                            // In order to see what is going wrong with the roll call if anything, display all of the player's information
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "Adding player '%s' to roll call...", currentPlayer.callsign.c_str());
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  BZID       : %s", currentPlayer.bzID.c_str());
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  IP Address : %s", currentPlayer.ipAddress.c_str());
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  Team Name  : %s", currentPlayer.teamName.c_str());
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  Team Color : %s", formatTeam(currentPlayer.teamColor).c_str());
-
-                            // Check if there is any need to invalidate a roll call from a team
-                            validateTeamName(invalidateRollcall, teamOneError, currentPlayer, teamOneMotto, TEAM_ONE);
-                            validateTeamName(invalidateRollcall, teamTwoError, currentPlayer, teamTwoMotto, TEAM_TWO);
-
-                            if (currentPlayer.bzID.empty()) // Someone is playing without a BZID, how did this happen?
-                            {
-                                invalidateRollcall = true;
-                                logMessage(pluginSettings.getVerboseLevel(), "error", "Roll call has been marked as invalid due to '%s' not having a valid BZID.", currentPlayer.callsign.c_str());
-                            }
-
-                            // Add the player to the struct of participants
-                            officialMatch->matchParticipants.push_back(currentPlayer);
-                            logMessage(pluginSettings.getVerboseLevel(), "debug", "Player '%s' successfully added to the roll call.", currentPlayer.callsign.c_str());
-                        }
-                    }
-
-                    // We were asked to invalidate the roll call because of some issue so let's check if there is still time for
-                    // another roll call
-                    if (invalidateRollcall && officialMatch->matchRollCall + 60 < officialMatch->duration)
-                    {
-                        logMessage(pluginSettings.getDebugLevel(), "debug", "Invalid player found on field at %s.", getMatchTime().c_str());
-
-                        // There was an error with one of the members of either team, so request a team name update for all of
-                        // the team members to try to fix any inconsistencies of different team names
-                        if (teamOneError) { requestTeamName(TEAM_ONE); }
-                        if (teamTwoError) { requestTeamName(TEAM_TWO); }
-
-                        // Delay the next roll call by 60 seconds
-                        officialMatch->matchRollCall += 60;
-                        logMessage(pluginSettings.getVerboseLevel(), "debug", "Match roll call time has been delayed by 60 seconds.");
-
-                        // Clear the struct because it's useless data
-                        officialMatch->matchParticipants.clear();
-                        logMessage(pluginSettings.getVerboseLevel(), "debug", "Match participants have been cleared.");
-                    }
-
-                    // There is no need to invalidate the roll call so the team names must be right so save them in the struct
-                    if (!invalidateRollcall)
-                    {
-                        officialMatch->teamOneName = teamOneMotto;
-                        officialMatch->teamTwoName = teamTwoMotto;
-
-                        logMessage(pluginSettings.getVerboseLevel(), "debug", "Team One set to: %s", officialMatch->teamOneName.c_str());
-                        logMessage(pluginSettings.getVerboseLevel(), "debug", "Team Two set to: %s", officialMatch->teamTwoName.c_str());
-                    }
-                }
-            }
         }
         break;
 
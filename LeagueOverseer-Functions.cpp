@@ -16,7 +16,10 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <set>
 #include <string>
 
 #include "LeagueOverseer.h"
@@ -54,6 +57,569 @@ std::string LeagueOverseer::buildBZIDString (bz_eTeamType team)
     return teamString.erase(teamString.size() - 1);
 }
 
+// Handle the replays the background worker has finished archiving and send off the match reports that were waiting
+// on them. While the plug-in is being unloaded, the reports are sent without a handler since we won't be around to
+// hear back from the league site.
+void LeagueOverseer::collectArchivedReplays (bool unloading)
+{
+    ReplayArchiver::Result result;
+
+    while (replayArchiver.collect(result))
+    {
+        if (result.success)
+        {
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Replay %s archived to %s (%lld bytes compressed to %lld bytes).",
+                result.fileName.c_str(), result.archivedPath.c_str(), result.originalSize, result.compressedSize);
+        }
+        else
+        {
+            logMessage(0, "error", "Replay %s could not be archived: %s", result.fileName.c_str(), result.error.c_str());
+        }
+
+        if (!result.indexPath.empty())
+        {
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Replay index saved to %s", result.indexPath.c_str());
+        }
+
+        // The replay counts against its budget wherever it ended up
+        if (replayRetention.running())
+        {
+            replayRetention.track((result.success) ? result.archivedPath : pluginSettings.getReplayDirectory() + "/" + result.fileName);
+        }
+
+        std::map<int, UrlQuery>::iterator report = pendingMatchReports.find(result.jobID);
+
+        if (report == pendingMatchReports.end())
+        {
+            continue;
+        }
+
+        if (result.success)
+        {
+            report->second.set("replayHash", result.hash)
+                          .set("replaySize", std::to_string(result.compressedSize));
+        }
+
+        logMessage(pluginSettings.getDebugLevel(), "debug", "Reporting match data...");
+
+        if (unloading)
+        {
+            report->second.setHandler(NULL);
+        }
+
+        report->second.submit();
+        pendingMatchReports.erase(report);
+
+        MATCH_INFO_SENT = !unloading;
+    }
+}
+
+// Record the players on the field and their team names; run by the roll call timer 'matchRollCall' seconds into an
+// official match
+void LeagueOverseer::processRollCall (void)
+{
+    TraceRecorder::Scope scope(tracer, "roll_call");
+
+    // The match may have been canceled or paused since the roll call was scheduled
+    if (!isOfficialMatch() || !officialMatch->matchParticipants.empty() || bz_isCountDownPaused() || bz_isCountDownInProgress())
+    {
+        return;
+    }
+
+    logMessage(pluginSettings.getVerboseLevel(), "debug", "Processing roll call...");
+
+    PlayerListHandle playerList(bz_getPlayerIndexList());
+    bool invalidateRollcall, teamOneError, teamTwoError;
+    std::string teamOneMotto, teamTwoMotto;
+
+    invalidateRollcall = teamOneError = teamTwoError = false;
+    teamOneMotto = teamTwoMotto = "";
+
+    // We can't do a roll call if the player list wasn't created
+    if (!playerList)
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "error", "Failure to create player list for roll call.");
+        metrics.increment(METRIC_ROLL_CALL_RETRIES);
+        scheduleRollCall(); // Try again on the next tick
+        return;
+    }
+
+    for (unsigned int i = 0; i < playerList->size(); i++)
+    {
+        PlayerRecordHandle playerRecord(bz_getPlayerByIndex(playerList->get(i)));
+
+        if (playerRecord && isLeagueMember(playerRecord->playerID) && bz_getPlayerTeam(playerList->get(i)) != eObservers) // If player is not an observer
+        {
+            MatchParticipant currentPlayer(playerRecord->bzID.c_str(), playerRecord->callsign.c_str(),
+                                           playerRecord->ipAddress.c_str(), getPlayerTeamNameByBZID(playerRecord->bzID.c_str()),
+                                           playerRecord->team);
+
+            // In order to see what is going wrong with the roll call if anything, display all of the player's information
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Adding player '%s' to roll call...", currentPlayer.callsign.c_str());
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  BZID       : %s", currentPlayer.bzID.c_str());
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  IP Address : %s", currentPlayer.ipAddress.c_str());
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  Team Name  : %s", currentPlayer.teamName.c_str());
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "  >  Team Color : %s", formatTeam(currentPlayer.teamColor).c_str());
+
+            // Check if there is any need to invalidate a roll call from a team
+            validateTeamName(invalidateRollcall, teamOneError, currentPlayer, teamOneMotto, TEAM_ONE);
+            validateTeamName(invalidateRollcall, teamTwoError, currentPlayer, teamTwoMotto, TEAM_TWO);
+
+            if (currentPlayer.bzID.empty()) // Someone is playing without a BZID, how did this happen?
+            {
+                invalidateRollcall = true;
+                logMessage(pluginSettings.getVerboseLevel(), "error", "Roll call has been marked as invalid due to '%s' not having a valid BZID.", currentPlayer.callsign.c_str());
+            }
+
+            // Add the player to the struct of participants
+            officialMatch->matchParticipants.push_back(currentPlayer);
+            logMessage(pluginSettings.getVerboseLevel(), "debug", "Player '%s' successfully added to the roll call.", currentPlayer.callsign.c_str());
+        }
+    }
+
+    // We were asked to invalidate the roll call because of some issue so let's check if there is still time for
+    // another roll call
+    if (invalidateRollcall && officialMatch->matchRollCall + 60 < officialMatch->duration)
+    {
+        char matchTime[MATCH_CLOCK_BUFFER_SIZE];
+        logMessage(pluginSettings.getDebugLevel(), "debug", "Invalid player found on field at %s.", getMatchTime(matchTime, sizeof(matchTime)));
+
+        // There was an error with one of the members of either team, so request a team name update for all of
+        // the team members to try to fix any inconsistencies of different team names
+        if (teamOneError) { requestTeamName(TEAM_ONE); }
+        if (teamTwoError) { requestTeamName(TEAM_TWO); }
+
+        // Delay the next roll call by 60 seconds
+        officialMatch->matchRollCall += 60;
+        metrics.increment(METRIC_ROLL_CALL_RETRIES);
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Match roll call time has been delayed by 60 seconds.");
+
+        // Clear the struct because it's useless data
+        officialMatch->matchParticipants.clear();
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Match participants have been cleared.");
+
+        scheduleRollCall();
+    }
+
+    // There is no need to invalidate the roll call so the team names must be right so save them in the struct
+    if (!invalidateRollcall)
+    {
+        officialMatch->teamOneName = teamOneMotto;
+        officialMatch->teamTwoName = teamTwoMotto;
+
+        matchTimeline.setTeamNames(teamOneMotto, teamTwoMotto);
+
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Team One set to: %s", officialMatch->teamOneName.c_str());
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Team Two set to: %s", officialMatch->teamTwoName.c_str());
+    }
+
+    publishMatchSnapshot();
+
+    if (eventBus.hasSubscribers())
+    {
+        LosBusEvent busEvent = createBusEvent(LOS_EVENT_ROLL_CALL);
+        busEvent.success = !invalidateRollcall;
+
+        if (busEvent.success)
+        {
+            snprintf(busEvent.detail, sizeof(busEvent.detail), "%s vs %s", teamOneMotto.c_str(), teamTwoMotto.c_str());
+        }
+
+        eventBus.publish(busEvent);
+    }
+}
+
+// (Re)schedule the roll call of the official match for when the match clock reaches 'matchRollCall'. The timer is
+// canceled while a match is paused so this is called again when it's resumed.
+void LeagueOverseer::scheduleRollCall (void)
+{
+    timers.cancel(rollCallTimer);
+    rollCallTimer = 0;
+
+    if (!isOfficialMatch() || !officialMatch->matchParticipants.empty())
+    {
+        return;
+    }
+
+    double now = bz_getCurrentTime();
+
+    rollCallTimer = timers.schedule(now, officialMatch->matchRollCall - matchClock.elapsed(now), [this]() {
+        rollCallTimer = 0;
+        processRollCall();
+    });
+}
+
+// Remember a league member who left the field during a match so they can rejoin their team within the next minute
+// instead of being sent to the observers like a player who just joined
+void LeagueOverseer::rememberActivePlayer (std::string bzID, bz_eTeamType team)
+{
+    double now = bz_getCurrentTime();
+
+    auto player = std::find_if(activePlayerList.begin(), activePlayerList.end(), [&bzID](const Player &p) { return p.bzID == bzID; });
+
+    if (player == activePlayerList.end())
+    {
+        activePlayerList.push_back(Player(bzID, team, now));
+        player = activePlayerList.end() - 1;
+    }
+    else
+    {
+        timers.cancel(player->expiry);
+        player->lastActiveTeam = team;
+        player->lastActive     = now;
+    }
+
+    player->expiry = timers.schedule(now, 60, [this, bzID]() {
+        activePlayerList.erase(std::remove_if(activePlayerList.begin(), activePlayerList.end(), [&bzID](const Player &p) { return p.bzID == bzID; }),
+                               activePlayerList.end());
+    });
+}
+
+// Forget every player we were remembering, along with the timers that would have removed them later
+void LeagueOverseer::clearActivePlayers (void)
+{
+    for (Player &player : activePlayerList)
+    {
+        timers.cancel(player.expiry);
+    }
+
+    activePlayerList.clear();
+}
+
+// Re-read the configuration file and apply only the options that have changed, rebuilding whatever depends on them.
+// Returns false if the file couldn't be read, in which case the current settings are kept.
+bool LeagueOverseer::reloadConfiguration (void)
+{
+    TraceRecorder::Scope scope(tracer, "reload_configuration");
+
+    ConfigurationOptions updatedSettings;
+
+    if (!updatedSettings.readConfigurationFile(CONFIG_PATH.c_str(), true))
+    {
+        return false;
+    }
+
+    std::vector<std::string> changes = pluginSettings.diff(updatedSettings);
+    std::set<std::string> changed(changes.begin(), changes.end());
+
+    if (changed.empty())
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "The configuration was reloaded without any changes.");
+        return true;
+    }
+
+    pluginSettings = updatedSettings;
+
+    for (auto option : changes)
+    {
+        logMessage(pluginSettings.getDebugLevel(), "debug", "Configuration option %s has been changed.", option.c_str());
+    }
+
+    if (changed.count("REPORT_RELAY_SOCKET"))
+    {
+        reportRelay.disconnect();
+
+        if (!pluginSettings.getReportRelaySocket().empty() && !reportRelay.connect(pluginSettings.getReportRelaySocket()))
+        {
+            logMessage(0, "warning", "The report relay at %s is not running. Requests will be sent directly until it can be reached.",
+                pluginSettings.getReportRelaySocket().c_str());
+        }
+    }
+
+    // Match reports that are already waiting on an archived replay keep the URL they were created with
+    if (changed.count("TEAM_NAME_URL") || changed.count("MATCH_REPORT_URL"))
+    {
+        TeamUrlRepo  = UrlQuery(this, pluginSettings.getTeamNameURL().c_str(), &reportRelay, &metrics);
+        MatchUrlRepo = UrlQuery(this, pluginSettings.getMatchReportURL().c_str(), &reportRelay, &metrics);
+    }
+
+    if (changed.count("ALLOW_LIMITED_CHAT") || changed.count("NO_TALK_MESSAGE"))
+    {
+        updateChatPolicy(isMatchInProgress());
+    }
+
+    if (changed.count("MOTTO_FETCH_ENABLED") || changed.count("TEAM_CACHE_NAME") || changed.count("TEAM_NAME_URL"))
+    {
+        teamCache.detach();
+        nextTeamCacheCheck = 0;
+        sharedTeamMottos.clear();
+        busyTeamLookups.clear();
+
+        if (pluginSettings.isMottoFetchEnabled())
+        {
+            if (!pluginSettings.getTeamCacheName().empty() && !teamCache.attach(pluginSettings.getTeamCacheName()))
+            {
+                logMessage(0, "error", "The shared team name cache '%s' could not be opened. This server will fetch its own team names.",
+                    pluginSettings.getTeamCacheName().c_str());
+            }
+
+            // An attached cache is refreshed by the next check if it needs to be
+            if (!teamCache.attached())
+            {
+                logMessage(pluginSettings.getVerboseLevel(), "debug", "Requesting team name database...");
+                TeamUrlRepo.set("query", "teamNameDump").submit();
+            }
+        }
+    }
+
+    if (changed.count("MUTE_LIST_ENABLED") || changed.count("MUTE_LIST_REFRESH") || changed.count("TEAM_NAME_URL"))
+    {
+        nextMuteListRefresh = 0;
+    }
+
+    if (changed.count("REPLAY_FUN_MAX_COUNT") || changed.count("REPLAY_FUN_MAX_SIZE") || changed.count("REPLAY_OFFICIAL_MAX_COUNT") || changed.count("REPLAY_OFFICIAL_MAX_SIZE"))
+    {
+        replayRetention.stop();
+        startReplayRetention();
+    }
+
+    // Replays that are waiting to be archived would be lost if the archiver was restarted now
+    if (changed.count("REPLAY_ARCHIVE_ENABLED") || changed.count("REPLAY_ARCHIVE_PATH") || changed.count("REPLAY_DIRECTORY"))
+    {
+        logMessage(0, "warning", "Changes to the replay archive and replay directory will take effect when the plug-in is reloaded.");
+    }
+
+    if (changed.count("METRICS_FILE") || changed.count("METRICS_INTERVAL"))
+    {
+        metrics.stop();
+        startMetrics();
+    }
+
+    if (changed.count("MAPCHANGE_PATH") || changed.count("ROTATIONAL_LEAGUE"))
+    {
+        MAP_NAME = "";
+
+        if (pluginSettings.getMapChangePath() != "" && pluginSettings.isRotationalLeague())
+        {
+            MAP_NAME = ConfigWatcher::readMapName(pluginSettings.getMapChangePath());
+            logMessage(pluginSettings.getDebugLevel(), "debug", "Current map being played: %s", MAP_NAME.c_str());
+        }
+
+        configWatcher.start(CONFIG_PATH, pluginSettings.isRotationalLeague() ? pluginSettings.getMapChangePath() : "");
+    }
+
+    return true;
+}
+
+// Start the worker that keeps the replays on disk within their budgets, if the server owner has set any
+void LeagueOverseer::startReplayRetention (void)
+{
+    if (!pluginSettings.isReplayRetentionEnabled())
+    {
+        return;
+    }
+
+    std::vector<std::string> replayDirectories = { pluginSettings.getReplayDirectory() };
+
+    // The archive is scanned on its own when it doesn't live inside of the replay directory
+    if (pluginSettings.isReplayArchiveEnabled() && pluginSettings.getReplayArchivePath().compare(0, pluginSettings.getReplayDirectory().size() + 1, pluginSettings.getReplayDirectory() + "/") != 0)
+    {
+        replayDirectories.push_back(pluginSettings.getReplayArchivePath());
+    }
+
+    ReplayRetention::Budget funBudget, officialBudget;
+
+    funBudget.maxCount      = pluginSettings.getFunReplayMaxCount();
+    funBudget.maxBytes      = pluginSettings.getFunReplayMaxSize() * 1024LL * 1024LL;
+    officialBudget.maxCount = pluginSettings.getOfficialReplayMaxCount();
+    officialBudget.maxBytes = pluginSettings.getOfficialReplayMaxSize() * 1024LL * 1024LL;
+
+    logMessage(pluginSettings.getVerboseLevel(), "debug", "Old replays will be removed to stay within the replay budgets");
+    replayRetention.start(replayDirectories, funBudget, officialBudget);
+}
+
+// Start writing the metrics file for node_exporter, if the server owner has given us one
+void LeagueOverseer::startMetrics (void)
+{
+    if (pluginSettings.getMetricsFile().empty())
+    {
+        return;
+    }
+
+    if (!metrics.start(pluginSettings.getMetricsFile(), pluginSettings.getMetricsInterval()))
+    {
+        logMessage(0, "error", "The metrics file %s could not be written. Metrics will not be exported.", pluginSettings.getMetricsFile().c_str());
+        return;
+    }
+
+    logMessage(pluginSettings.getVerboseLevel(), "debug", "Metrics will be written to %s every %d seconds", pluginSettings.getMetricsFile().c_str(), pluginSettings.getMetricsInterval());
+}
+
+// Look up which team each flag on the map belongs to so flag grabs can be checked by flag ID
+void LeagueOverseer::buildFlagTeamTable (void)
+{
+    unsigned int flagCount = bz_getNumFlags();
+
+    flagTeams.assign(flagCount, eNoTeam);
+
+    for (unsigned int i = 0; i < flagCount; i++)
+    {
+        flagTeams[i] = getTeamTypeFromFlag(bz_getFlagName(i).c_str());
+    }
+}
+
+// Ask the league site for the changes to the mute list since the version we have; version 0 gets the whole list
+void LeagueOverseer::requestMuteList (void)
+{
+    time_t now = time(NULL);
+
+    if (now < nextMuteListRefresh)
+    {
+        return;
+    }
+
+    nextMuteListRefresh = now + pluginSettings.getMuteListRefresh() * 60;
+
+    logMessage(pluginSettings.getVerboseLevel(), "debug", "Requesting mute list changes since version %d...", muteList.getVersion());
+    TeamUrlRepo.set("query", "muteList")
+               .set("version", muteList.getVersion())
+               .submit();
+}
+
+// Rebuild the chat policy table after the configuration or the state of a match has changed
+void LeagueOverseer::updateChatPolicy (bool matchInProgress)
+{
+    chatPolicy.build(pluginSettings.isAllowLimitedChat(), matchInProgress);
+    noTalkMessage = pluginSettings.getNoTalkMessage();
+}
+
+// Take over the shared team names if the server that was refreshing them has gone away, and refresh them once
+// they're out of date
+void LeagueOverseer::checkTeamCache (void)
+{
+    time_t now = time(NULL);
+
+    // Finish the lookups that found the table busy. If it's still busy, the writer may have died in the middle of a
+    // publish, so ask the league site once; the answer is kept in teamMottos and found first from then on.
+    if (!busyTeamLookups.empty())
+    {
+        std::set<std::string> lookups;
+        lookups.swap(busyTeamLookups);
+
+        for (auto &bzID : lookups)
+        {
+            std::string teamName;
+
+            switch (teamCache.lookup(bzID, teamName))
+            {
+                case SharedTeamCache::FOUND:
+                    sharedTeamMottos[bzID] = teamName;
+                    break;
+
+                case SharedTeamCache::BUSY:
+                    logMessage(pluginSettings.getDebugLevel(), "debug", "Sending motto request for BZID %s", bzID.c_str());
+                    TeamUrlRepo.set("query", "teamName").set("bzid", bzID).submit();
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    // There's no need to check this every tick
+    if (now < nextTeamCacheCheck)
+    {
+        return;
+    }
+
+    nextTeamCacheCheck = now + 30;
+
+    if (teamCache.elect())
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "This server is now refreshing the shared team names.");
+    }
+
+    if (teamCache.isWriter() && teamCache.isStale(pluginSettings.getTeamCacheRefresh() * 60))
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Requesting team name database...");
+        TeamUrlRepo.set("query", "teamNameDump").submit();
+
+        // Give the league site time to answer before asking again
+        nextTeamCacheCheck = now + pluginSettings.getTeamCacheRefresh() * 60;
+    }
+}
+
+// Log the replays that the retention worker removed to stay within the replay budgets
+void LeagueOverseer::collectEvictedReplays (void)
+{
+    ReplayRetention::Eviction eviction;
+
+    while (replayRetention.collect(eviction))
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "Replay %s (%lld bytes) was removed to stay within the replay budget.",
+            eviction.path.c_str(), eviction.size);
+    }
+}
+
+// Write the index of a replay next to it when the replay isn't being archived
+void LeagueOverseer::saveReplayIndex (std::string replayName, const std::string &index)
+{
+    if (pluginSettings.getReplayDirectory().empty())
+    {
+        logMessage(pluginSettings.getVerboseLevel(), "debug", "The 'REPLAY_DIRECTORY' option is not set so the index for %s was not saved.", replayName.c_str());
+        return;
+    }
+
+    std::string indexPath = pluginSettings.getReplayDirectory() + "/" + replayName + ".idx";
+    std::ofstream indexFile(indexPath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    indexFile << index;
+
+    if (!indexFile)
+    {
+        logMessage(0, "error", "The replay index could not be written to %s", indexPath.c_str());
+    }
+}
+
+// Create an event for the subscribers of the event bus with the information every event carries
+LosBusEvent LeagueOverseer::createBusEvent (LosBusEventType type, int playerID)
+{
+    LosBusEvent event = LosBusEvent();
+
+    event.type      = type;
+    event.official  = isOfficialMatch();
+    event.playerID  = playerID;
+    event.team      = eNoTeam;
+    event.otherTeam = eNoTeam;
+    event.eventTime = bz_getCurrentTime();
+
+    if (isOfficialMatch())
+    {
+        event.teamOneScore = officialMatch->teamOnePoints;
+        event.teamTwoScore = officialMatch->teamTwoPoints;
+    }
+
+    if (playerID >= 0)
+    {
+        PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
+
+        if (playerData)
+        {
+            event.team = playerData->team;
+            snprintf(event.bzID, sizeof(event.bzID), "%s", playerData->bzID.c_str());
+        }
+    }
+
+    return event;
+}
+
+// Get the BZID of a league member from their callsign; an empty string is returned for anyone else
+std::string LeagueOverseer::getBZIDByCallsign (std::string callsign)
+{
+    std::map<std::string, int>::iterator player = CALLSIGN_MAP.find(callsign);
+
+    return (player != CALLSIGN_MAP.end()) ? getBZIDByID(player->second) : "";
+}
+
+// Get the BZID of a player from their player slot
+std::string LeagueOverseer::getBZIDByID (int playerID)
+{
+    PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
+
+    return (playerData) ? playerData->bzID.c_str() : "";
+}
+
 bz_BasePlayerRecord* LeagueOverseer::bz_getPlayerByCallsign (const char* callsign)
 {
     return bz_getPlayerByIndex(CALLSIGN_MAP[callsign]);
@@ -92,61 +658,80 @@ int LeagueOverseer::getMatchProgress (void)
 {
     if (isMatchInProgress())
     {
-        time_t now = time(NULL);
-
-        return difftime(now, MATCH_START);
+        return (int)matchClock.elapsed(bz_getCurrentTime());
     }
 
     return -1;
 }
 
-// Get the literal time remaining in a match in the format of MM:SS
-std::string LeagueOverseer::getMatchTime (void)
+// Write the time remaining in the match as MM:SS into the buffer, which should hold MATCH_CLOCK_BUFFER_SIZE characters
+const char* LeagueOverseer::getMatchTime (char *buffer, size_t size)
 {
-    int time = getMatchProgress();
-
-    // We could not get the current match progress
-    if (getMatchProgress() < 0)
+    if (!isMatchInProgress())
     {
-        return "-00:00";
+        snprintf(buffer, size, "-00:00");
+        return buffer;
     }
 
-    // Let's covert the seconds of a match's progress into minutes and seconds
-    int minutes = (officialMatch->duration/60) - ceil(time / 60.0);
-    int seconds = 60 - (time % 60);
-
-    // We need to store the literal values
-    std::string minutesLiteral,
-                secondsLiteral;
-
-    // If the minutes remaining are less than 10 (only has one digit), then prepend a 0 to keep the format properly
-    minutesLiteral = (minutes < 10) ? "0" : "";
-    minutesLiteral += std::to_string(minutes);
-
-    // Do some formatting for seconds similarly to minutes
-    if (seconds == 60)
-    {
-        secondsLiteral = "00";
-    }
-    else
-    {
-        secondsLiteral = (seconds < 10) ? "0" : "";
-        secondsLiteral += std::to_string(seconds);
-    }
-
-    return minutesLiteral + ":" + secondsLiteral;
+    return matchClock.format(bz_getCurrentTime(), buffer, size);
 }
 
 std::string LeagueOverseer::getPlayerTeamNameByID (int playerID)
 {
-    std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+    PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
     return getPlayerTeamNameByBZID(playerData->bzID.c_str());
 }
 
 std::string LeagueOverseer::getPlayerTeamNameByBZID (std::string bzID)
 {
-    return teamMottos[bzID];
+    TeamNameMottoMap::iterator motto = teamMottos.find(bzID);
+    std::string teamName;
+
+    if (motto != teamMottos.end())
+    {
+        return motto->second;
+    }
+
+    // Fall back to the team names shared by the other servers on this host
+    if (teamCache.attached())
+    {
+        SharedTeamCache::LookupResult result = teamCache.lookup(bzID, teamName);
+
+        // A publish only takes a moment, so give it one more chance to finish
+        if (result == SharedTeamCache::BUSY)
+        {
+            result = teamCache.lookup(bzID, teamName);
+        }
+
+        switch (result)
+        {
+            case SharedTeamCache::FOUND:
+                sharedTeamMottos[bzID] = teamName;
+                return teamName;
+
+            // The table is still being replaced, so use the name we found last time. Without one, check again on the
+            // next tick so the next lookup finds it.
+            case SharedTeamCache::BUSY:
+            {
+                TeamNameMottoMap::iterator lastKnown = sharedTeamMottos.find(bzID);
+
+                if (lastKnown != sharedTeamMottos.end())
+                {
+                    return lastKnown->second;
+                }
+
+                logMessage(pluginSettings.getVerboseLevel(), "debug", "The shared team names were busy, BZID %s will be looked up again.", bzID.c_str());
+                busyTeamLookups.insert(bzID);
+            }
+            break;
+
+            default:
+                break;
+        }
+    }
+
+    return "";
 }
 
 // Check if a player is part of the league
@@ -176,30 +761,102 @@ bool LeagueOverseer::isOfficialMatchInProgress (void)
 // Check if a player was already on the server within 5 minutes of their last part
 bool LeagueOverseer::playerAlreadyJoined (std::string bzID)
 {
-    // Loop through all of the players on the list
-    for (unsigned int i = 0; i < activePlayerList.size(); i++)
+    // Players are removed from the list by their timer a minute after they left, so anyone on it left recently
+    for (auto &player : activePlayerList)
     {
-        // The player has their BZID saved as being active
-        if (activePlayerList.at(i).bzID == bzID)
+        if (player.bzID == bzID)
         {
-            // If they left at least 1 minute ago, then update their last active time and consider them active
-            if (activePlayerList.at(i).lastActive + 60 > bz_getCurrentTime())
-            {
-                activePlayerList.at(i).lastActive = bz_getCurrentTime();
-                return true;
-            }
-            else // Their BZID was saved but it's been more than 5 minutes, remove them and mark them as they were not active
-            {
-                activePlayerList.erase(activePlayerList.begin() + i, activePlayerList.begin() + i + 1);
-                return false;
-            }
+            return true;
         }
     }
 
-    // They weren't saved on the list
     return false;
 }
 
+// Figure out the state of the match from BZFS and publish a new snapshot for other plug-ins
+void LeagueOverseer::publishMatchSnapshot (void)
+{
+    MatchSnapshotState state = MATCH_STATE_NONE;
+
+    if (bz_isCountDownInProgress())
+    {
+        state = MATCH_STATE_COUNTDOWN;
+    }
+    else if (bz_isCountDownPaused())
+    {
+        state = MATCH_STATE_PAUSED;
+    }
+    else if (bz_isCountDownActive())
+    {
+        state = MATCH_STATE_RUNNING;
+    }
+
+    publishMatchSnapshot(state);
+}
+
+// Publish a new snapshot of the match for other plug-ins when we already know what state the match is in
+void LeagueOverseer::publishMatchSnapshot (MatchSnapshotState state)
+{
+    // Every change to the state of a match comes through here, so this is where the chat policy follows it
+    updateChatPolicy(state != MATCH_STATE_NONE);
+
+    MatchSnapshot snapshot = MatchSnapshot();
+
+    snapshot.state        = state;
+    snapshot.official     = isOfficialMatch();
+    snapshot.teamOneColor = TEAM_ONE;
+    snapshot.teamTwoColor = TEAM_TWO;
+    snapshot.updatedAt    = bz_getCurrentTime();
+
+    if (isOfficialMatch())
+    {
+        snapshot.teamOneScore = officialMatch->teamOnePoints;
+        snapshot.teamTwoScore = officialMatch->teamTwoPoints;
+        snapshot.rosterSize   = officialMatch->matchParticipants.size();
+    }
+
+    if (state == MATCH_STATE_RUNNING || state == MATCH_STATE_PAUSED)
+    {
+        snapshot.timeRemaining = matchClock.remaining(bz_getCurrentTime()) * 1000;
+    }
+
+    matchSnapshot.publish(snapshot);
+}
+
+// Queue lines of text to be sent to a player over the next few ticks
+void LeagueOverseer::queueMessages (int playerID, const std::vector<std::string> &lines)
+{
+    std::deque<std::string> &queue = queuedMessages[playerID];
+
+    queue.insert(queue.end(), lines.begin(), lines.end());
+}
+
+// Send the next few queued lines to each player that is waiting on output; called once every tick
+void LeagueOverseer::sendQueuedMessages (void)
+{
+    static const int MESSAGES_PER_TICK = 4;
+
+    for (std::map<int, std::deque<std::string>>::iterator it = queuedMessages.begin(); it != queuedMessages.end(); )
+    {
+        std::deque<std::string> &queue = it->second;
+
+        for (int i = 0; i < MESSAGES_PER_TICK && !queue.empty(); i++)
+        {
+            bz_sendTextMessage(BZ_SERVER, it->first, queue.front().c_str());
+            queue.pop_front();
+        }
+
+        if (queue.empty())
+        {
+            queuedMessages.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 // Forget a player from the local database of player information
 void LeagueOverseer::removePlayerInfo(std::string bzID, std::string callsign)
 {
@@ -218,7 +875,7 @@ void LeagueOverseer::removePlayerInfo(std::string bzID, std::string callsign)
 void LeagueOverseer::requestTeamName (bz_eTeamType team)
 {
     logMessage(pluginSettings.getVerboseLevel(), "debug", "A team name update for the '%s' team has been requested.", formatTeam(team).c_str());
-    std::shared_ptr<bz_APIIntList> playerList(bz_getPlayerIndexList());
+    PlayerListHandle playerList(bz_getPlayerIndexList());
 
     // Our player list couldn't be created so exit out of here
     if (!playerList)
@@ -229,7 +886,7 @@ void LeagueOverseer::requestTeamName (bz_eTeamType team)
 
     for (unsigned int i = 0; i < playerList->size(); i++)
     {
-        std::shared_ptr<bz_BasePlayerRecord> playerRecord(bz_getPlayerByIndex(playerList->get(i)));
+        PlayerRecordHandle playerRecord(bz_getPlayerByIndex(playerList->get(i)));
 
         if (playerRecord && playerRecord->team == team) // Only request a new team name for the players of a certain team
         {
@@ -259,7 +916,7 @@ void LeagueOverseer::resetTimeLimit()
 // Check the player's user groups to see if they belong to the league and save that value
 void LeagueOverseer::setLeagueMember (int playerID)
 {
-    std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+    PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
     IS_LEAGUE_MEMBER[playerID] = false;
 
@@ -16,11 +16,27 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
+
 #include "LeagueOverseer.h"
 #include "LeagueOverseer-Helpers.h"
 
 int LeagueOverseer::GeneralCallback (const char* name, void* data)
 {
+    // Other plug-ins may poll for a snapshot every tick so this callback is handled first and without logging
+    if (strcmp(name, "GetMatchSnapshot") == 0)
+    {
+        MatchSnapshot* snapshot = (MatchSnapshot*)data;
+
+        if (!snapshot || snapshot->version != MATCH_SNAPSHOT_VERSION)
+        {
+            return 0;
+        }
+
+        matchSnapshot.read(*snapshot);
+        return 1;
+    }
+
 	logMessage(pluginSettings.getVerboseLevel(), "callback", "A plug-in has requested the '%s' callback.", name);
 
     // Store the callback that is being called for easy access
@@ -35,13 +51,25 @@ int LeagueOverseer::GeneralCallback (const char* name, void* data)
     }
     else if (callbackOption == "GetMatchTime")
     {
-        std::string matchTime = getMatchTime();
+        char matchTime[MATCH_CLOCK_BUFFER_SIZE];
+        getMatchTime(matchTime, sizeof(matchTime));
 
-        strcpy((char*)data, matchTime.c_str());
+        strcpy((char*)data, matchTime);
 
-        logMessage(pluginSettings.getVerboseLevel(), "callback", "Returning the current match time (%s)...", matchTime.c_str());
+        logMessage(pluginSettings.getVerboseLevel(), "callback", "Returning the current match time (%s)...", matchTime);
         return 1;
     }
+    else if (callbackOption == "SubscribeMatchEvents")
+    {
+        int subscriptionID = eventBus.subscribe((LosEventSubscription*)data);
+
+        logMessage(pluginSettings.getVerboseLevel(), "callback", "Match event subscription %s.", (subscriptionID) ? "registered" : "refused");
+        return subscriptionID;
+    }
+    else if (callbackOption == "UnsubscribeMatchEvents")
+    {
+        return (int)eventBus.unsubscribe((LosEventSubscription*)data);
+    }
     else if (callbackOption == "IsOfficialMatch")
     {
         bool isOfficial = isOfficialMatch();
@@ -26,6 +26,7 @@ League Overseer
 
 #include "LeagueOverseer-Helpers.h"
 #include "LeagueOverseer-Version.h"
+#include "TimestampCache.h"
 
 std::vector<std::string> split (std::string string, std::string delimeter)
 {
@@ -82,17 +83,47 @@ std::string formatTeam (bz_eTeamType teamColor, bool addWhiteSpace, int totalCha
     return color;
 }
 
-const char* getCurrentTimeStamp(std::string format)
+// The time stamps we hand out are shared by every caller
+static TimestampCache timestampCache;
+
+const bz_Time& getCurrentUTCTime (void)
+{
+    return timestampCache.utcTime();
+}
+
+const char* getCurrentTimeStamp (void)
 {
-    // Get the current standard UTC time
-    bz_Time standardTime;
-    bz_getUTCtime(&standardTime);
+    return timestampCache.dateTime();
+}
 
-    // Format the date to -> year-month-day hour:minute:second
-    char matchDate[20];
-    sprintf(matchDate, format.c_str(), standardTime.year, standardTime.month, standardTime.day, standardTime.hour, standardTime.minute, standardTime.second);
+const char* getCurrentFileTimeStamp (void)
+{
+    return timestampCache.fileDateTime();
+}
 
-    return std::string(matchDate).c_str();
+const char* getEventName (bz_eEventType eventType)
+{
+    switch (eventType)
+    {
+        case bz_eAllowFlagGrab:       return "allow_flag_grab";
+        case bz_eAllowSpawn:          return "allow_spawn";
+        case bz_eBZDBChange:          return "bzdb_change";
+        case bz_eCaptureEvent:        return "capture";
+        case bz_eGameEndEvent:        return "game_end";
+        case bz_eGamePauseEvent:      return "game_pause";
+        case bz_eGameResumeEvent:     return "game_resume";
+        case bz_eGameStartEvent:      return "game_start";
+        case bz_eGetAutoTeamEvent:    return "get_auto_team";
+        case bz_eGetPlayerMotto:      return "get_player_motto";
+        case bz_ePlayerDieEvent:      return "player_die";
+        case bz_ePlayerJoinEvent:     return "player_join";
+        case bz_ePlayerPartEvent:     return "player_part";
+        case bz_eRawChatMessageEvent: return "raw_chat_message";
+        case bz_eSlashCommandEvent:   return "slash_command";
+        case bz_eTickEvent:           return "tick";
+
+        default:                      return NULL;
+    }
 }
 
 bz_eTeamType getTeamTypeFromFlag(std::string flagAbbr)
@@ -130,41 +161,7 @@ void logMessage (int debugLevel, const char* msgType, const char* fmt, ...)
     bz_debugMessage(debugLevel, message.c_str());
 }
 
-void modifyPerms(bool grant, std::string perm)
-{
-    // Use a smart pointer so we don't have to worry about freeing up the memory
-    // when we're done. In other words, laziness.
-    std::shared_ptr<bz_APIIntList> playerList(bz_getPlayerIndexList());
-
-    // Be sure the playerlist exists
-    if (playerList)
-    {
-        // Loop through all of the players' callsigns
-        for (unsigned int i = 0; i < playerList->size(); i++)
-        {
-            if (grant)
-            {
-                bz_grantPerm(playerList->get(i), perm.c_str());
-            }
-            else
-            {
-                bz_revokePerm(playerList->get(i), perm.c_str());
-            }
-        }
-    }
-}
-
-void grantPermToAll(std::string perm)
-{
-    modifyPerms(true, perm);
-}
-
-void revokePermFromAll(std::string perm)
-{
-    modifyPerms(false, perm);
-}
-
-void sendPluginMessage (int playerID, bool sendCustomMessage, std::vector<std::string> message, DefaultMsgType msgToSend)
+void sendPluginMessage (int playerID, bool sendCustomMessage, const std::vector<std::string> &message, DefaultMsgType msgToSend)
 {
     if (sendCustomMessage) // We want to send the players a custom message
     {
@@ -209,7 +206,7 @@ bool isInteger(std::string str)
 bool isValidPlayerID (int playerID)
 {
     // Use another smart pointer so we don't forget about freeing up memory
-    std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+    PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
     // If the pointer doesn't exist, that means the playerID does not exist
     return (playerData) ? true : false;
@@ -19,6 +19,7 @@ League Overseer
 #ifndef __PLUGIN_HELPERS_H__
 #define __PLUGIN_HELPERS_H__
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,16 @@ enum DefaultMsgType
     LAST_MSG_TYPE
 };
 
+// Player records and lists are allocated by the server so they have to be given back to the server to be freed
+struct ApiDeleter
+{
+    void operator() (bz_BasePlayerRecord *record) const { bz_freePlayerRecord(record); }
+    void operator() (bz_APIIntList *list) const         { bz_deleteIntList(list); }
+};
+
+typedef std::unique_ptr<bz_BasePlayerRecord, ApiDeleter> PlayerRecordHandle;
+typedef std::unique_ptr<bz_APIIntList, ApiDeleter>       PlayerListHandle;
+
 /**
  * Split a string by a delimeter and return a vector of elements
  *
@@ -64,54 +75,53 @@ std::string boolToString (bool value);
 std::string formatTeam (bz_eTeamType teamColor, bool addWhiteSpace = false, int totalCharacters = 7);
 
 /**
- * Get the current time stamp in the specified format
+ * Get the current UTC time, which is only looked up again once a second
  *
- * @param  format The format you'd like the timestamp to be formatted into
- *
- * @return        A formatted timestamp
+ * @return The current UTC time
  */
-const char* getCurrentTimeStamp(std::string format = "%02d-%02d-%02d %02d:%02d:%02d");
+const bz_Time& getCurrentUTCTime (void);
 
 /**
- * Get the bz_eTeamType from a flag abbreviation
- *
- * @param  flagAbbr The flag abbreviation we're searching for
+ * Get the current UTC time stamp formatted as year-month-day hour:minute:second
  *
- * @return          The team the flag belongs to. Return eNoTeam if the flag is not a team flag
+ * @return A buffer shared by every caller that's updated once a second; copy it if it needs to be kept
  */
-bz_eTeamType getTeamTypeFromFlag(std::string flagAbbr);
+const char* getCurrentTimeStamp (void);
 
 /**
- * Output a formatted debug message that will follow a similar syntax and can be easily found in the log file.
- *    (example) MSG TYPE :: League Overseer :: A sample message that has been written to the log file
+ * Get the current UTC time stamp formatted as yearmonthday-hourminutesecond so it can be used in file names
  *
- * @param debugLevel The debug level that at which this message will be outputted to the log file
- * @param msgType    The type of the message. For example: debug, verbose, error, warning
- * @param fmt        The format of the message that will accept placeholders
+ * @return A buffer shared by every caller that's updated once a second; copy it if it needs to be kept
  */
-void logMessage (int debugLevel, const char* msgType, const char* fmt, ...);
+const char* getCurrentFileTimeStamp (void);
 
 /**
- * Modify the perms of all of the players on the server
+ * Get a short name for one of the events the plug-in registers for
  *
- * @param grant True if you'd like to grant a specific permission. False to remove it.
- * @param perm  The server permission you'd like to revoke or grant
+ * @param  eventType The type of the event
+ *
+ * @return           The name of the event or NULL if it's not one we register for
  */
-void modifyPerms(bool grant, std::string perm);
+const char* getEventName (bz_eEventType eventType);
 
 /**
- * A convenience method for modifyPerms() that will grant permissions
+ * Get the bz_eTeamType from a flag abbreviation
  *
- * @param perm The permission that you would like to grant to everyone
+ * @param  flagAbbr The flag abbreviation we're searching for
+ *
+ * @return          The team the flag belongs to. Return eNoTeam if the flag is not a team flag
  */
-void grantPermToAll(std::string perm);
+bz_eTeamType getTeamTypeFromFlag(std::string flagAbbr);
 
 /**
- * A convenience method for modifyPerms() that will revoke permissions
+ * Output a formatted debug message that will follow a similar syntax and can be easily found in the log file.
+ *    (example) MSG TYPE :: League Overseer :: A sample message that has been written to the log file
  *
- * @param perm The permission that you would like to revoke from everyone
+ * @param debugLevel The debug level that at which this message will be outputted to the log file
+ * @param msgType    The type of the message. For example: debug, verbose, error, warning
+ * @param fmt        The format of the message that will accept placeholders
  */
-void revokePermFromAll(std::string perm);
+void logMessage (int debugLevel, const char* msgType, const char* fmt, ...);
 
 /**
  * Send a player a message that is stored in a vector
@@ -121,7 +131,7 @@ void revokePermFromAll(std::string perm);
  * @param message           A vector containing the message sent to player
  * @param msgToSend         The type of message sent
  */
-void sendPluginMessage (int playerID, bool sendCustomMessage, std::vector<std::string> message, DefaultMsgType msgToSend);
+void sendPluginMessage (int playerID, bool sendCustomMessage, const std::vector<std::string> &message, DefaultMsgType msgToSend);
 
 /**
  * Check if a string is an integer
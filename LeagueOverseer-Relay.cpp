@@ -0,0 +1,482 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A companion daemon for hosts that run several servers with the plug-in. Each server hands its league site requests
+// (match reports, team names) to the daemon over a Unix domain socket instead of sending them itself. The daemon:
+//
+//   - sends everything that is queued in one go over a single connection that is kept alive between requests
+//   - sends identical requests that are waiting at the same time only once and gives every server the same answer
+//   - retries requests that failed to reach the league site, and keeps sending a server's reports after that
+//     server has gone away
+//
+//     Usage: LeagueOverseerRelay [-r retries] <socket path>
+//
+// Point the plug-in at the daemon with the REPORT_RELAY_SOCKET configuration option.
+
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <curl/curl.h>
+#include <deque>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "ReportRelayProtocol.h"
+
+struct Job
+{
+    uint32_t    jobID;
+    std::string url,
+                postData;
+};
+
+struct Result
+{
+    uint32_t    jobID;
+    uint8_t     status;
+    int32_t     code;
+    std::string body;
+};
+
+struct Waiter
+{
+    uint64_t client;    // The connection that asked; clients are numbered so a recycled descriptor is never confused with an old one
+    uint32_t requestID;
+};
+
+struct Client
+{
+    int         fd;
+    std::string inbound,
+                outbound;
+};
+
+static volatile sig_atomic_t stopping = 0;
+
+static std::mutex              queueMutex;
+static std::condition_variable queueWake;
+static std::deque<Job>         jobs;
+static std::deque<Result>      results;
+static bool                    workerDone = false;
+
+static int wakePipe[2];
+static int maxRetries = 3;
+
+static void handleSignal (int /*signal*/)
+{
+    stopping = 1;
+}
+
+static size_t appendBody (char* data, size_t size, size_t count, void* body)
+{
+    ((std::string*)body)->append(data, size * count);
+
+    return size * count;
+}
+
+// Send one request to the league site over the shared handle; curl keeps the connection open for the next one
+static Result sendUpstream (CURL* curl, const Job &job)
+{
+    Result result;
+    result.jobID  = job.jobID;
+    result.status = RELAY_ERROR;
+    result.code   = 0;
+
+    for (int attempt = 0; attempt <= maxRetries; attempt++)
+    {
+        if (attempt > 0)
+        {
+            sleep(1 << (attempt - 1));
+        }
+
+        result.body.clear();
+
+        curl_easy_setopt(curl, CURLOPT_URL,           job.url.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS,    job.postData.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)job.postData.size());
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA,     &result.body);
+
+        CURLcode code = curl_easy_perform(curl);
+
+        if (code == CURLE_OK)
+        {
+            long httpCode = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+
+            result.code   = (int32_t)httpCode;
+            result.status = (httpCode < 400) ? RELAY_OK : RELAY_ERROR;
+
+            if (result.status == RELAY_ERROR)
+            {
+                result.body = "HTTP error " + std::to_string(httpCode);
+            }
+
+            // The league site answered, so there's no point in asking again
+            return result;
+        }
+
+        result.code   = (int32_t)code;
+        result.status = (code == CURLE_OPERATION_TIMEDOUT) ? RELAY_TIMEOUT : RELAY_ERROR;
+        result.body   = curl_easy_strerror(code);
+
+        // Only a request that never reached the league site is safe to send again. Anything later may have been
+        // received already, and sending a match report twice files the match twice.
+        if (code != CURLE_COULDNT_CONNECT && code != CURLE_COULDNT_RESOLVE_HOST)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+static void runWorker (void)
+{
+    CURL* curl = curl_easy_init();
+
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendBody);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT,       60L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL,      1L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT,     "LeagueOverseerRelay");
+
+    while (true)
+    {
+        std::deque<Job> batch;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+
+            while (jobs.empty() && !workerDone)
+            {
+                queueWake.wait(lock);
+            }
+
+            if (jobs.empty())
+            {
+                break;
+            }
+
+            batch.swap(jobs);
+        }
+
+        for (auto &job : batch)
+        {
+            Result result = sendUpstream(curl, job);
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                results.push_back(result);
+            }
+
+            // Wake up the main loop so it can hand the answer back
+            char wake = 1;
+            (void)!write(wakePipe[1], &wake, 1);
+        }
+    }
+
+    curl_easy_cleanup(curl);
+}
+
+static int listenOn (const char* path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "The socket path is too long: %s\n", path);
+        return -1;
+    }
+
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    // A socket left behind by a previous run would make bind() fail
+    unlink(path);
+
+    if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 16) != 0)
+    {
+        fprintf(stderr, "Could not listen on %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    return fd;
+}
+
+int main (int argc, char* argv[])
+{
+    const char* socketPath = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+            maxRetries = atoi(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            socketPath = argv[i];
+        }
+    }
+
+    if (!socketPath)
+    {
+        fprintf(stderr, "Usage: %s [-r retries] <socket path>\n", argv[0]);
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT,  handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    int listener = listenOn(socketPath);
+
+    if (listener < 0 || pipe(wakePipe) != 0)
+    {
+        return 1;
+    }
+
+    fcntl(wakePipe[0], F_SETFL, fcntl(wakePipe[0], F_GETFL) | O_NONBLOCK);
+
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    std::thread worker(runWorker);
+
+    std::map<uint64_t, Client>              clients;
+    std::map<std::string, uint32_t>         inFlight;   // The job sending each distinct request
+    std::map<uint32_t, std::vector<Waiter>> waiters;    // Who is waiting on each job
+    std::map<uint32_t, std::string>         jobKeys;
+
+    uint64_t nextClient = 1;
+    uint32_t nextJob    = 1;
+
+    while (!stopping)
+    {
+        std::vector<struct pollfd> fds;
+        std::vector<uint64_t>      owners;
+
+        fds.push_back({ listener,    POLLIN, 0 });
+        fds.push_back({ wakePipe[0], POLLIN, 0 });
+
+        for (auto &client : clients)
+        {
+            fds.push_back({ client.second.fd, (short)(POLLIN | (client.second.outbound.empty() ? 0 : POLLOUT)), 0 });
+            owners.push_back(client.first);
+        }
+
+        if (::poll(&fds[0], fds.size(), 1000) < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            int fd;
+
+            while ((fd = accept(listener, NULL, NULL)) >= 0)
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                clients[nextClient++].fd = fd;
+            }
+        }
+
+        // Hand the answers from the league site back to everyone who asked
+        if (fds[1].revents & POLLIN)
+        {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+
+            std::deque<Result> finished;
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                finished.swap(results);
+            }
+
+            for (auto &result : finished)
+            {
+                for (auto &waiter : waiters[result.jobID])
+                {
+                    std::map<uint64_t, Client>::iterator client = clients.find(waiter.client);
+
+                    // The server went away but its request was still sent
+                    if (client == clients.end())
+                    {
+                        continue;
+                    }
+
+                    RelayFrame frame;
+                    memset(&frame, 0, sizeof(frame));
+
+                    frame.length = result.body.size();
+                    frame.id     = waiter.requestID;
+                    frame.type   = RELAY_RESPONSE;
+                    frame.status = result.status;
+                    frame.code   = result.code;
+
+                    client->second.outbound.append((const char*)&frame, sizeof(frame));
+                    client->second.outbound.append(result.body);
+                }
+
+                inFlight.erase(jobKeys[result.jobID]);
+                jobKeys.erase(result.jobID);
+                waiters.erase(result.jobID);
+            }
+        }
+
+        std::deque<Job> newJobs;
+
+        for (size_t i = 2; i < fds.size(); i++)
+        {
+            Client &client = clients[owners[i - 2]];
+            bool    closed = (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) && !(fds[i].revents & POLLIN);
+
+            if (fds[i].revents & POLLIN)
+            {
+                char    buffer[16384];
+                ssize_t bytesRead;
+
+                while ((bytesRead = recv(client.fd, buffer, sizeof(buffer), 0)) > 0)
+                {
+                    client.inbound.append(buffer, bytesRead);
+                }
+
+                closed = (bytesRead == 0 || (bytesRead < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR));
+            }
+
+            size_t offset = 0;
+
+            while (client.inbound.size() - offset >= sizeof(RelayFrame))
+            {
+                RelayFrame frame;
+                memcpy(&frame, client.inbound.data() + offset, sizeof(frame));
+
+                if (frame.length > RELAY_MAX_PAYLOAD)
+                {
+                    closed = true;
+                    break;
+                }
+
+                if (client.inbound.size() - offset - sizeof(frame) < frame.length)
+                {
+                    break;
+                }
+
+                const char* payload = client.inbound.data() + offset + sizeof(frame);
+                offset += sizeof(frame) + frame.length;
+
+                // The URL and the POST data are separated by a NUL byte
+                const char* separator = (const char*)memchr(payload, '\0', frame.length);
+
+                if (frame.type != RELAY_REQUEST || !separator)
+                {
+                    continue;
+                }
+
+                std::string key(payload, frame.length);
+                Waiter waiter = { owners[i - 2], frame.id };
+
+                std::map<std::string, uint32_t>::iterator sending = inFlight.find(key);
+
+                if (sending != inFlight.end())
+                {
+                    waiters[sending->second].push_back(waiter);
+                    continue;
+                }
+
+                Job job;
+                job.jobID    = nextJob++;
+                job.url      = std::string(payload, separator - payload);
+                job.postData = std::string(separator + 1, payload + frame.length - separator - 1);
+
+                inFlight[key]           = job.jobID;
+                jobKeys[job.jobID]      = key;
+                waiters[job.jobID].push_back(waiter);
+
+                newJobs.push_back(job);
+            }
+
+            client.inbound.erase(0, offset);
+
+            while (!closed && !client.outbound.empty())
+            {
+                ssize_t written = send(client.fd, client.outbound.data(), client.outbound.size(), MSG_NOSIGNAL);
+
+                if (written < 0)
+                {
+                    closed = (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                    break;
+                }
+
+                client.outbound.erase(0, written);
+            }
+
+            if (closed)
+            {
+                close(client.fd);
+                clients.erase(owners[i - 2]);
+            }
+        }
+
+        if (!newJobs.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                jobs.insert(jobs.end(), newJobs.begin(), newJobs.end());
+            }
+
+            queueWake.notify_one();
+        }
+    }
+
+    // Stop taking requests but finish sending the ones we already have
+    close(listener);
+    unlink(socketPath);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        workerDone = true;
+    }
+
+    queueWake.notify_one();
+    worker.join();
+
+    for (auto &client : clients)
+    {
+        close(client.second.fd);
+    }
+
+    curl_global_cleanup();
+
+    return 0;
+}
\ No newline at end of file
@@ -16,12 +16,128 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdint>
+#include <cstring>
+
 #include "LeagueOverseer.h"
 #include "LeagueOverseer-Helpers.h"
 
+///
+/// Dispatch table
+///
+/// Every command the plug-in registers has an entry in SLASH_COMMAND_TABLE. The name of a command is hashed into one of
+/// the slots of SLASH_COMMAND_SLOTS, which holds the index of its entry; both tables are built by the compiler, and the
+/// static_assert below refuses to build if two commands ever end up in the same slot. If adding a command trips it,
+/// try other values of SLASH_COMMAND_SEED until it builds.
+///
+
+#define SLASH_COMMAND_SEED      31u
+#define SLASH_COMMAND_SLOT_BITS 6
+
+// FNV-1a over the name of the command...
+constexpr uint32_t slashCommandHash (const char* name, uint32_t hash = SLASH_COMMAND_SEED)
+{
+    return (*name) ? slashCommandHash(name + 1, (hash ^ (uint8_t)*name) * 16777619u) : hash;
+}
+
+// ...with a Fibonacci multiply so the slot can be taken from the well mixed top bits
+constexpr int slashCommandSlot (const char* name)
+{
+    return (int)((uint32_t)(slashCommandHash(name) * 2654435769u) >> (32 - SLASH_COMMAND_SLOT_BITS));
+}
+
+static constexpr LeagueOverseer::SlashCommandEntry SLASH_COMMAND_TABLE[] = {
+    // name              handler                                  permission        throttled
+    { "cancel",          &LeagueOverseer::slashCancel,           nullptr,          false },
+    { "f",               &LeagueOverseer::slashFunMatch,         nullptr,          false },
+    { "finish",          &LeagueOverseer::slashFinish,           nullptr,          false },
+    { "fm",              &LeagueOverseer::slashFunMatch,         nullptr,          false },
+    { "lodbg",           &LeagueOverseer::slashDebug,            "shutdownserver", false },
+    { "leagueoverseer",  &LeagueOverseer::slashLeagueOverseer,   "shutdownserver", false },
+    { "los",             &LeagueOverseer::slashLeagueOverseer,   "shutdownserver", false },
+    { "o",               &LeagueOverseer::slashOfficial,         nullptr,          true  },
+    { "offi",            &LeagueOverseer::slashOfficial,         nullptr,          true  },
+    { "official",        &LeagueOverseer::slashOfficial,         nullptr,          true  },
+    { "p",               &LeagueOverseer::slashPause,            nullptr,          false },
+    { "pause",           &LeagueOverseer::slashPause,            nullptr,          false },
+    { "r",               &LeagueOverseer::slashResume,           nullptr,          false },
+    { "resume",          &LeagueOverseer::slashResume,           nullptr,          false },
+    { "showhidden",      &LeagueOverseer::slashShowHidden,       "ban",            true  },
+    { "spawn",           &LeagueOverseer::slashSpawn,            "ban",            false },
+    { "s",               &LeagueOverseer::slashStats,            nullptr,          true  },
+    { "stats",           &LeagueOverseer::slashStats,            nullptr,          true  },
+    { "timelimit",       &LeagueOverseer::slashTimeLimit,        nullptr,          false }
+};
+
+static constexpr int SLASH_COMMAND_COUNT = sizeof(SLASH_COMMAND_TABLE) / sizeof(SLASH_COMMAND_TABLE[0]);
+
+// The index of the entry hashed into a slot, or -1 if the slot is empty
+constexpr int findSlashCommand (int slot, int index = 0)
+{
+    return (index >= SLASH_COMMAND_COUNT) ? -1 : (slashCommandSlot(SLASH_COMMAND_TABLE[index].name) == slot) ? index : findSlashCommand(slot, index + 1);
+}
+
+constexpr bool slashCommandSlotsUnique (int i = 0, int j = 1)
+{
+    return (i >= SLASH_COMMAND_COUNT) ? true :
+           (j >= SLASH_COMMAND_COUNT) ? slashCommandSlotsUnique(i + 1, i + 2) :
+           (slashCommandSlot(SLASH_COMMAND_TABLE[i].name) != slashCommandSlot(SLASH_COMMAND_TABLE[j].name)) && slashCommandSlotsUnique(i, j + 1);
+}
+
+static_assert(slashCommandSlotsUnique(), "Two slash commands hash into the same slot; pick another SLASH_COMMAND_SEED");
+
+#define SLASH_COMMAND_SLOTS_8(n) \
+    findSlashCommand(n),     findSlashCommand(n + 1), findSlashCommand(n + 2), findSlashCommand(n + 3), \
+    findSlashCommand(n + 4), findSlashCommand(n + 5), findSlashCommand(n + 6), findSlashCommand(n + 7)
+
+static constexpr int8_t SLASH_COMMAND_SLOTS[1 << SLASH_COMMAND_SLOT_BITS] = {
+    SLASH_COMMAND_SLOTS_8(0),  SLASH_COMMAND_SLOTS_8(8),  SLASH_COMMAND_SLOTS_8(16), SLASH_COMMAND_SLOTS_8(24),
+    SLASH_COMMAND_SLOTS_8(32), SLASH_COMMAND_SLOTS_8(40), SLASH_COMMAND_SLOTS_8(48), SLASH_COMMAND_SLOTS_8(56)
+};
+
+void LeagueOverseer::registerSlashCommands (void)
+{
+    for (const SlashCommandEntry &entry : SLASH_COMMAND_TABLE)
+    {
+        bz_registerCustomSlashCommand(entry.name, this);
+    }
+}
+
+void LeagueOverseer::removeSlashCommands (void)
+{
+    for (const SlashCommandEntry &entry : SLASH_COMMAND_TABLE)
+    {
+        bz_removeCustomSlashCommand(entry.name);
+    }
+}
+
 bool LeagueOverseer::SlashCommand (int playerID, bz_ApiString command, bz_ApiString /*message*/, bz_APIStringList *params)
 {
-	std::shared_ptr<bz_BasePlayerRecord> playerData(bz_getPlayerByIndex(playerID));
+	int index = SLASH_COMMAND_SLOTS[slashCommandSlot(command.c_str())];
+
+	// Only the commands we've registered are sent to us, but make sure that the slot really holds this command
+	if (index < 0 || strcmp(SLASH_COMMAND_TABLE[index].name, command.c_str()) != 0)
+	{
+	    return false;
+	}
+
+	const SlashCommandEntry &entry = SLASH_COMMAND_TABLE[index];
+
+	TraceRecorder::Scope scope(tracer, entry.name);
+
+	// The commands that send a lot of output or start a lot of work are throttled before anything else is done. Only
+	// the first refused attempt is answered so spamming the command doesn't turn into spamming the notice.
+	if (entry.throttled && !rateLimiter.take(playerID, RATE_LIMIT_COMMAND, bz_getCurrentTime()))
+	{
+	    if (rateLimiter.suppressed(playerID, RATE_LIMIT_COMMAND) == 1)
+	    {
+	        bz_sendTextMessagef(BZ_SERVER, playerID, "You are using the /%s command too quickly, please wait a few seconds.", command.c_str());
+	    }
+
+	    return true;
+	}
+
+	PlayerRecordHandle playerData(bz_getPlayerByIndex(playerID));
 
 	// For some reason, the player record could not be created
 	if (!playerData)
@@ -29,415 +145,460 @@ bool LeagueOverseer::SlashCommand (int playerID, bz_ApiString command, bz_ApiStr
 	    return true;
 	}
 
-	// If the player is not verified and does not have the spawn permission, they can't use any of the commands
-	if (!playerData->verified || !isLeagueMember(playerID))
+	// If the player is not verified and does not have the spawn permission, they can't use any of the commands. Some
+	// commands need an additional BZFS permission as well
+	if (!playerData->verified || !isLeagueMember(playerID) || (entry.permission && !bz_hasPerm(playerID, entry.permission)))
 	{
 	    bz_sendTextMessagef(BZ_SERVER, playerID, "You do not have permission to run the /%s command.", command.c_str());
 	    return true;
 	}
 
-	if (command == "cancel")
+	(this->*entry.handler)(playerID, playerData.get(), params);
+
+	return true;
+}
+
+// Cancel the match in progress
+void LeagueOverseer::slashCancel (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList* /*params*/)
+{
+	if (playerData->team == eObservers) // Observers can't cancel matches
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to cancel matches.");
+	}
+	else if (bz_isCountDownInProgress()) // There's no way to stop a countdown so let's not cancel during a countdown
+	{
+	    bz_cancelCountdown(playerData->callsign.c_str());
+	    publishMatchSnapshot(MATCH_STATE_NONE);
+	}
+	else if (bz_isCountDownActive()) // We can only cancel a match if the countdown is active
 	{
-	    if (playerData->team == eObservers) // Observers can't cancel matches
+	    // We're canceling an official match
+	    if (isOfficialMatch())
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to cancel matches.");
+	        officialMatch->canceled = true;
+	        officialMatch->cancelationReason = "Official match cancellation requested by " + std::string(playerData->callsign.c_str());
 	    }
-	    else if (bz_isCountDownInProgress()) // There's no way to stop a countdown so let's not cancel during a countdown
+	    else // Cancel the fun match like normal
 	    {
-	        bz_cancelCountdown(playerData->callsign.c_str());
+	        bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Fun match ended by %s", playerData->callsign.c_str());
 	    }
-	    else if (bz_isCountDownActive()) // We can only cancel a match if the countdown is active
-	    {
-	        // We're canceling an official match
-	        if (isOfficialMatch())
-	        {
-	            officialMatch->canceled = true;
-	            officialMatch->cancelationReason = "Official match cancellation requested by " + std::string(playerData->callsign.c_str());
-	        }
-	        else // Cancel the fun match like normal
-	        {
-	            bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Fun match ended by %s", playerData->callsign.c_str());
-	        }
 
-	        logMessage(pluginSettings.getDebugLevel(), "debug", "Match ended by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
-	        bz_gameOver(253, eObservers);
-	    }
-	    else
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is no match in progress to cancel.");
-	    }
+	    logMessage(pluginSettings.getDebugLevel(), "debug", "Match ended by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
+	    bz_gameOver(253, eObservers);
 	}
-	else if (command == "finish")
+	else
 	{
-	    if (playerData->team == eObservers) // Observers can't cancel matches
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to cancel matches.");
-	    }
-	    else if (bz_isCountDownInProgress()) // There's no way to stop a countdown so let's not finish during a countdown
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You may only finish a match after it has started.");
-	    }
-	    else if (bz_isCountDownActive()) // Only finish if the countdown is active
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is no match in progress to cancel.");
+	}
+}
+
+// End an official match early and report it, as long as at least half of it has been played
+void LeagueOverseer::slashFinish (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList* /*params*/)
+{
+	if (playerData->team == eObservers) // Observers can't cancel matches
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to cancel matches.");
+	}
+	else if (bz_isCountDownInProgress()) // There's no way to stop a countdown so let's not finish during a countdown
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "You may only finish a match after it has started.");
+	}
+	else if (bz_isCountDownActive()) // Only finish if the countdown is active
+	{
+	    // We can only '/finish' official matches because I wanted to have a command only dedicated to
+	    // reporting partially completed matches
+	    if (isOfficialMatch())
 	    {
-	        // We can only '/finish' official matches because I wanted to have a command only dedicated to
-	        // reporting partially completed matches
-	        if (isOfficialMatch())
+	        // Let's check if we can report the match, in other words, at least half of the match has been reported
+	        if (matchClock.elapsed(bz_getCurrentTime()) >= officialMatch->duration / 2)
 	        {
-	            // Let's check if we can report the match, in other words, at least half of the match has been reported
-	            if (getMatchProgress() >= officialMatch->duration / 2)
-	            {
-	                logMessage(pluginSettings.getDebugLevel(), "debug", "Official match ended early by %s (%s)", playerData->callsign.c_str(), playerData->ipAddress.c_str());
-	                bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Official match ended early by %s", playerData->callsign.c_str());
+	            logMessage(pluginSettings.getDebugLevel(), "debug", "Official match ended early by %s (%s)", playerData->callsign.c_str(), playerData->ipAddress.c_str());
+	            bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Official match ended early by %s", playerData->callsign.c_str());
 
-	                bz_gameOver(253, eObservers);
-	            }
-	            else
-	            {
-	                bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, I cannot automatically report a match less than half way through.");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "Please use the /cancel command and message a referee for review of this match.");
-	            }
+	            bz_gameOver(253, eObservers);
 	        }
 	        else
 	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "You cannot /finish a fun match. Use /cancel instead.");
+	            bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, I cannot automatically report a match less than half way through.");
+	            bz_sendTextMessage(BZ_SERVER, playerID, "Please use the /cancel command and message a referee for review of this match.");
 	        }
 	    }
 	    else
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is no match in progress to end.");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "You cannot /finish a fun match. Use /cancel instead.");
 	    }
 	}
-	else if (command == "f" || command == "fm")
+	else
 	{
-	    if (pluginSettings.areFunMatchesDisabled())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, this server has not be configured for fun matches.");
-	    }
-	    else if (playerData->team == eObservers) // Observers can't start matches
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is no match in progress to end.");
+	}
+}
+
+// Start a fun match
+void LeagueOverseer::slashFunMatch (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params)
+{
+	if (pluginSettings.areFunMatchesDisabled())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, this server has not be configured for fun matches.");
+	}
+	else if (playerData->team == eObservers) // Observers can't start matches
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to start matches.");
+	}
+	else if (isOfficialMatch() || bz_isCountDownActive() || bz_isCountDownInProgress()) // There is already a countdown
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is already a game in progress; you cannot start another.");
+	}
+	else // They are verified, not an observer, there is no match. So start one
+	{
+	    // We signify an FM whenever the 'officialMatch' variable is set to NULL so set it to null
+	    officialMatch = NULL;
+
+	    // Log the actions
+	    logMessage(pluginSettings.getDebugLevel(), "debug", "Fun match started by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
+	    bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Fun match started by %s.", playerData->callsign.c_str());
+
+	    // The amount of seconds the countdown should take
+	    int timeToStart = (params->size() == 1) ? atoi(params->get(0).c_str()) : 10;
+
+	    // Sanity check...
+	    if (timeToStart <= 60 && timeToStart >= 10)
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to start matches.");
+	        bz_startCountdown(timeToStart, bz_getTimeLimit(), "Server"); // Start the countdown with a custom countdown time limit under 1 minute
 	    }
-	    else if (isOfficialMatch() || bz_isCountDownActive() || bz_isCountDownInProgress()) // There is already a countdown
+	    else
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is already a game in progress; you cannot start another.");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "Holy sanity check, Batman! Let's not have a countdown last longer than 60 seconds or less than 10.");
+	        bz_startCountdown(10, bz_getTimeLimit(), "Server"); // Start the countdown for the official match
 	    }
-	    else // They are verified, not an observer, there is no match. So start one
-	    {
-	        // We signify an FM whenever the 'officialMatch' variable is set to NULL so set it to null
-	        officialMatch = NULL;
 
-	        // Log the actions
-	        logMessage(pluginSettings.getDebugLevel(), "debug", "Fun match started by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
-	        bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Fun match started by %s.", playerData->callsign.c_str());
+	    publishMatchSnapshot(MATCH_STATE_COUNTDOWN);
+	}
+}
 
-	        // The amount of seconds the countdown should take
-	        int timeToStart = (params->size() == 1) ? atoi(params->get(0).c_str()) : 10;
+// Manage the plug-in itself
+void LeagueOverseer::slashLeagueOverseer (int playerID, bz_BasePlayerRecord* /*playerData*/, bz_APIStringList *params)
+{
+	if (params->size() > 0)
+	{
+	    std::string commandOption = params->get(0).c_str();
 
-	        // Sanity check...
-	        if (timeToStart <= 60 && timeToStart >= 10)
+	    if (commandOption == "reload")
+	    {
+	        if (reloadConfiguration())
 	        {
-	            bz_startCountdown(timeToStart, bz_getTimeLimit(), "Server"); // Start the countdown with a custom countdown time limit under 1 minute
+	            bz_sendTextMessage(BZ_SERVER, playerID, "League Overseer plug-in configuration reloaded.");
 	        }
 	        else
 	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "Holy sanity check, Batman! Let's not have a countdown last longer than 60 seconds or less than 10.");
-	            bz_startCountdown(10, bz_getTimeLimit(), "Server"); // Start the countdown for the official match
+	            bz_sendTextMessage(BZ_SERVER, playerID, "The League Overseer configuration has errors and was not reloaded.");
 	        }
 	    }
 	}
-	else if (command == "leagueoverseer" || command == "los")
+}
+
+// In-game debugging commands for server owners
+void LeagueOverseer::slashDebug (int playerID, bz_BasePlayerRecord* /*playerData*/, bz_APIStringList *params)
+{
+	if (pluginSettings.isInGameDebugEnabled())
 	{
-	    if (bz_hasPerm(playerID, "shutdownserver"))
+	    if (params->size() > 0)
 	    {
-	        if (params->size() > 0)
+	        std::string commandOption = params->get(0).c_str();
+
+	        if (commandOption == "grant_perm" || commandOption == "revoke_perm")
 	        {
-	            std::string commandOption = params->get(0).c_str();
+	            if (params->size() == 3)
+	            {
+	                PlayerRecordHandle victim(getPlayerFromCallsignOrID(params->get(1).c_str()));
 
-	            if (commandOption == "reload")
+	                if (!victim)
+	                {
+	                    bz_sendTextMessagef(BZ_SERVER, playerID, "player %s not found", params->get(1).c_str());
+	                }
+	                else if (commandOption == "grant_perm")
+	                {
+	                    bz_grantPerm(victim->playerID, params->get(2).c_str());
+	                }
+	                else if (commandOption == "revoke_perm")
+	                {
+	                    bz_revokePerm(victim->playerID, params->get(2).c_str());
+	                }
+	            }
+	            else
 	            {
-	                pluginSettings.readConfigurationFile(CONFIG_PATH.c_str());
-	                bz_sendTextMessage(BZ_SERVER, playerID, "League Overseer plug-in configuration reloaded.");
+	                bz_sendTextMessagef(BZ_SERVER, playerID, "Syntax: /lodbg %s <player id or callsign> <permission name>", commandOption.c_str());
 	            }
 	        }
-	    }
-	    else
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You do not have permission to modify the League Overseer configuration.");
-	    }
-	}
-	else if (command == "lodbg")
-	{
-	    if (pluginSettings.isInGameDebugEnabled())
-	    {
-	        if (bz_hasPerm(playerID, "shutdownserver"))
+	        else if (commandOption == "trace")
 	        {
-	            if (params->size() > 0)
+	            std::string traceOption = (params->size() == 2) ? params->get(1).c_str() : "";
+
+	            if (traceOption == "start")
+	            {
+	                tracer.start();
+	                bz_sendTextMessagef(BZ_SERVER, playerID, "Tracing started. Up to %d spans will be recorded until '/lodbg trace stop'.", TRACE_BUFFER_SIZE);
+	            }
+	            else if (traceOption == "stop" && tracer.recording())
 	            {
-	                std::string commandOption = params->get(0).c_str();
+	                int spans   = tracer.spanCount(),
+	                    dropped = tracer.dropped();
 
-	                if (commandOption == "grant_perm" || commandOption == "revoke_perm")
+	                std::string tracePath = std::string("LeagueOverseer-") + getCurrentFileTimeStamp() + ".trace.json";
+
+	                if (tracer.stop(tracePath))
+	                {
+	                    bz_sendTextMessagef(BZ_SERVER, playerID, "Tracing stopped. %d spans written to %s (%d dropped).", spans, tracePath.c_str(), dropped);
+	                    logMessage(pluginSettings.getDebugLevel(), "debug", "A trace of %d spans has been written to %s.", spans, tracePath.c_str());
+	                }
+	                else
 	                {
-	                    if (params->size() == 3)
-	                    {
-	                        int victimID = getPlayerFromCallsignOrID(params->get(1).c_str())->playerID;
-
-	                        if (commandOption == "grant_perm")
-	                        {
-	                            bz_grantPerm(victimID, params->get(2).c_str());
-	                        }
-	                        else if (commandOption == "revoke_perm")
-	                        {
-	                            bz_revokePerm(victimID, params->get(2).c_str());
-	                        }
-	                    }
-	                    else
-	                    {
-	                        bz_sendTextMessagef(BZ_SERVER, playerID, "Syntax: /lodbg %s <player id or callsign> <permission name>", commandOption.c_str());
-	                    }
+	                    bz_sendTextMessagef(BZ_SERVER, playerID, "Tracing stopped but the trace could not be written to %s.", tracePath.c_str());
 	                }
 	            }
+	            else if (traceOption == "stop")
+	            {
+	                bz_sendTextMessage(BZ_SERVER, playerID, "There is no trace being recorded.");
+	            }
 	            else
 	            {
-	                bz_sendTextMessage(BZ_SERVER, playerID, "League Overseer In-Game Debug Commands");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "--------------------------------------");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "   /lodbg <option> <parameters>");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "   Options");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "   -------");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "     - grant_perm <player id or callsign> <permission name>");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "     - revoke_perm <player id or callsign> <permission name>");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "     - set");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "         - config_option <option> <value>");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "     - show");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "         - match_stats");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "         - player_stats <player id or callsign>");
-	                bz_sendTextMessage(BZ_SERVER, playerID, "         - config_options");
+	                bz_sendTextMessage(BZ_SERVER, playerID, "Syntax: /lodbg trace <start|stop>");
 	            }
 	        }
-	        else
-	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "You do not have permission to use the /lodbg command.");
-	        }
 	    }
 	    else
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "The League Overseer Debug command is disabled on production servers.");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "League Overseer In-Game Debug Commands");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "--------------------------------------");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "   /lodbg <option> <parameters>");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "   Options");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "   -------");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "     - grant_perm <player id or callsign> <permission name>");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "     - revoke_perm <player id or callsign> <permission name>");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "     - set");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "         - config_option <option> <value>");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "     - show");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "         - match_stats");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "         - player_stats <player id or callsign>");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "         - config_options");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "     - trace <start|stop>");
 	    }
 	}
-	else if (command == "o" || command == "offi" || command == "official")
+	else
 	{
-	    if (pluginSettings.areOfficialMatchesDisabled())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, this server has not be configured for official matches.");
-	    }
-	    else if (bz_pollActive())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You are not allowed to start a match while a poll is active.");
-	    }
-	    else if (playerData->team == eObservers) // Observers can't start matches
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to start matches.");
-	    }
-	    else if (bz_getTeamCount(TEAM_ONE) < 2 || bz_getTeamCount(TEAM_TWO) < 2) // An official match cannot be 1v1 or 2v1
+	    bz_sendTextMessage(BZ_SERVER, playerID, "The League Overseer Debug command is disabled on production servers.");
+	}
+}
+
+// Start an official match
+void LeagueOverseer::slashOfficial (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params)
+{
+	if (pluginSettings.areOfficialMatchesDisabled())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Sorry, this server has not be configured for official matches.");
+	}
+	else if (bz_pollActive())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "You are not allowed to start a match while a poll is active.");
+	}
+	else if (playerData->team == eObservers) // Observers can't start matches
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Observers are not allowed to start matches.");
+	}
+	else if (bz_getTeamCount(TEAM_ONE) < 2 || bz_getTeamCount(TEAM_TWO) < 2) // An official match cannot be 1v1 or 2v1
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "You may not have an official match with less than 2 players per team.");
+	}
+	else if (isOfficialMatch() || bz_isCountDownActive() || bz_isCountDownInProgress()) // A countdown is in progress already
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is already a game in progress; you cannot start another.");
+	}
+	else // They are verified non-observer with valid team sizes and no existing match. Start one!
+	{
+	    officialMatch.reset(new OfficialMatch()); // It's an official match
+
+	    // Log the actions so admins can bug brad to look at detailed information
+	    logMessage(pluginSettings.getDebugLevel(), "debug", "Official match started by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
+	    bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Official match started by %s.", playerData->callsign.c_str());
+
+	    // The amount of seconds the countdown should take
+	    int timeToStart = (params->size() == 1) ? atoi(params->get(0).c_str()) : 10;
+
+	    // Sanity check...
+	    if (timeToStart <= 60 && timeToStart >= 10)
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You may not have an official match with less than 2 players per team.");
+	        bz_startCountdown(timeToStart, bz_getTimeLimit(), "Server"); // Start the countdown with a custom countdown time limit under 1 minute
 	    }
-	    else if (isOfficialMatch() || bz_isCountDownActive() || bz_isCountDownInProgress()) // A countdown is in progress already
+	    else
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is already a game in progress; you cannot start another.");
+	        bz_sendTextMessage(BZ_SERVER, playerID, "Holy sanity check, Batman! Let's not have a countdown last longer than 60 seconds or less than 10.");
+	        bz_startCountdown(10, bz_getTimeLimit(), "Server"); // Start the countdown for the official match
 	    }
-	    else // They are verified non-observer with valid team sizes and no existing match. Start one!
-	    {
-	        officialMatch.reset(new OfficialMatch()); // It's an official match
 
-	        // Log the actions so admins can bug brad to look at detailed information
-	        logMessage(pluginSettings.getDebugLevel(), "debug", "Official match started by %s (%s).", playerData->callsign.c_str(), playerData->ipAddress.c_str());
-	        bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Official match started by %s.", playerData->callsign.c_str());
+	    publishMatchSnapshot(MATCH_STATE_COUNTDOWN);
+	}
+}
 
-	        // The amount of seconds the countdown should take
-	        int timeToStart = (params->size() == 1) ? atoi(params->get(0).c_str()) : 10;
+// Pause the match in progress
+void LeagueOverseer::slashPause (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList* /*params*/)
+{
+	if (bz_isCountDownPaused())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "The match is already paused!");
+	}
+	else if (bz_isCountDownActive())
+	{
+	    bz_pauseCountdown(playerData->callsign.c_str());
+	}
+	else
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is no active match to pause right now.");
+	}
+}
 
-	        // Sanity check...
-	        if (timeToStart <= 60 && timeToStart >= 10)
-	        {
-	            bz_startCountdown(timeToStart, bz_getTimeLimit(), "Server"); // Start the countdown with a custom countdown time limit under 1 minute
-	        }
-	        else
-	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "Holy sanity check, Batman! Let's not have a countdown last longer than 60 seconds or less than 10.");
-	            bz_startCountdown(10, bz_getTimeLimit(), "Server"); // Start the countdown for the official match
-	        }
-	    }
+// Resume a paused match
+void LeagueOverseer::slashResume (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList* /*params*/)
+{
+	if (bz_pollActive())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "You are not allowed to resume a match while a poll is active.");
 	}
-	else if (command == "p" || command == "pause")
+	else if (!bz_isCountDownPaused())
 	{
-	    if (bz_isCountDownPaused())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "The match is already paused!");
-	    }
-	    else if (bz_isCountDownActive())
-	    {
-	        bz_pauseCountdown(playerData->callsign.c_str());
-	    }
-	    else
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is no active match to pause right now.");
-	    }
+	    bz_sendTextMessage(BZ_SERVER, playerID, "The match is not paused!");
 	}
-	else if (command == "r" || command == "resume")
+	else if (bz_isCountDownActive())
 	{
-	    if (bz_pollActive())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You are not allowed to resume a match while a poll is active.");
-	    }
-	    else if (!bz_isCountDownPaused())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "The match is not paused!");
-	    }
-	    else if (bz_isCountDownActive())
-	    {
-	        bz_resumeCountdown(playerData->callsign.c_str());
+	    bz_resumeCountdown(playerData->callsign.c_str());
 
-	        if (isOfficialMatch())
-	        {
-	            logMessage(pluginSettings.getVerboseLevel(), "debug", "Match resumed by %s.", playerData->callsign.c_str());
-	        }
-	    }
-	    else
+	    if (isOfficialMatch())
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "There is no active match to resume right now.");
+	        logMessage(pluginSettings.getVerboseLevel(), "debug", "Match resumed by %s.", playerData->callsign.c_str());
 	    }
 	}
-	else if (command == "showhidden")
+	else
 	{
-	    if (bz_hasPerm(playerID, "ban"))
-	    {
-	        std::shared_ptr<bz_APIIntList> playerList(bz_getPlayerIndexList());
+	    bz_sendTextMessage(BZ_SERVER, playerID, "There is no active match to resume right now.");
+	}
+}
 
-	        // Our player list couldn't be created so exit out of here
-	        if (!playerList)
-	        {
-	            logMessage(pluginSettings.getVerboseLevel(), "debug", "Oops. I couldn't create a playerlist for some odd reason.");
-	            bz_sendTextMessage(BZ_SERVER, playerID, "Seems like I darn goofed, please execute your command again.");
-	            return true;
-	        }
+// List the hidden admins on the server
+void LeagueOverseer::slashShowHidden (int playerID, bz_BasePlayerRecord* /*playerData*/, bz_APIStringList* /*params*/)
+{
+	PlayerListHandle playerList(bz_getPlayerIndexList());
 
-	        bz_sendTextMessage(BZ_SERVER, playerID, "Hidden Admins Present");
-	        bz_sendTextMessage(BZ_SERVER, playerID, "---------------------");
+	// Our player list couldn't be created so exit out of here
+	if (!playerList)
+	{
+	    logMessage(pluginSettings.getVerboseLevel(), "debug", "Oops. I couldn't create a playerlist for some odd reason.");
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Seems like I darn goofed, please execute your command again.");
+	    return;
+	}
 
-	        for (unsigned int i = 0; i < playerList->size(); i++)
+	bz_sendTextMessage(BZ_SERVER, playerID, "Hidden Admins Present");
+	bz_sendTextMessage(BZ_SERVER, playerID, "---------------------");
+
+	for (unsigned int i = 0; i < playerList->size(); i++)
+	{
+	    // If the player is hidden, then show them in the list
+	    if (bz_hasPerm(playerList->get(i), "hideadmin"))
+	    {
+	        PlayerRecordHandle hiddenAdmin(bz_getPlayerByIndex(playerList->get(i)));
+
+	        if (hiddenAdmin)
 	        {
-	            // If the player is hidden, then show them in the list
-	            if (bz_hasPerm(playerList->get(i), "hideadmin"))
-	            {
-	                bz_sendTextMessagef(BZ_SERVER, playerID, " - %s", bz_getPlayerByIndex(playerList->get(i))->callsign.c_str());
-	            }
+	            bz_sendTextMessagef(BZ_SERVER, playerID, " - %s", hiddenAdmin->callsign.c_str());
 	        }
 	    }
-	    else
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You do not have permission to use the /showhidden command.");
-	    }
 	}
-	else if (command == "spawn")
+}
+
+// Give a player the ability to spawn
+void LeagueOverseer::slashSpawn (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params)
+{
+	if (params->size() > 0)
 	{
-	    if (bz_hasPerm(playerID, "ban"))
-	    {
-	        if (params->size() > 0)
-	        {
-	            logMessage(pluginSettings.getVerboseLevel(), "debug", "%s has executed the /spawn command.", playerData->callsign.c_str());
+	    logMessage(pluginSettings.getVerboseLevel(), "debug", "%s has executed the /spawn command.", playerData->callsign.c_str());
 
-	            std::string callsignOrID = params->get(0).c_str(); // Store the callsign we're going to search for
+	    std::string callsignOrID = params->get(0).c_str(); // Store the callsign we're going to search for
 
-	            logMessage(pluginSettings.getVerboseLevel(), "debug", "Callsign or Player slot to look for: %s", callsignOrID.c_str());
+	    logMessage(pluginSettings.getVerboseLevel(), "debug", "Callsign or Player slot to look for: %s", callsignOrID.c_str());
 
-	            std::shared_ptr<bz_BasePlayerRecord> victim(getPlayerFromCallsignOrID(callsignOrID.c_str()));
+	    PlayerRecordHandle victim(getPlayerFromCallsignOrID(callsignOrID.c_str()));
 
-	            if (victim)
-	            {
-	                bz_grantPerm(victim->playerID, "spawn");
-	                bz_sendTextMessagef(BZ_SERVER, eAdministrators, "%s granted %s the ability to spawn.", playerData->callsign.c_str(), victim->callsign.c_str());
-	            }
-	            else
-	            {
-	                bz_sendTextMessagef(BZ_SERVER, playerID, "player %s not found", callsignOrID.c_str());
-	                logMessage(pluginSettings.getVerboseLevel(), "debug", "Player %s was not found.", callsignOrID.c_str());
-	            }
-	        }
-	        else
-	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "/spawn <player id or callsign>");
-	        }
+	    if (victim)
+	    {
+	        bz_grantPerm(victim->playerID, "spawn");
+	        bz_sendTextMessagef(BZ_SERVER, eAdministrators, "%s granted %s the ability to spawn.", playerData->callsign.c_str(), victim->callsign.c_str());
 	    }
 	    else
 	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You do not have permission to use the /spawn command.");
+	        bz_sendTextMessagef(BZ_SERVER, playerID, "player %s not found", callsignOrID.c_str());
+	        logMessage(pluginSettings.getVerboseLevel(), "debug", "Player %s was not found.", callsignOrID.c_str());
 	    }
 	}
-	else if (command == "s" || command == "stats")
+	else
 	{
-	    if (isLeagueMember(playerID))
-	    {
-	        if (isOfficialMatch())
-	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "Match Data");
-	            bz_sendTextMessage(BZ_SERVER, playerID, "----------");
+	    bz_sendTextMessage(BZ_SERVER, playerID, "/spawn <player id or callsign>");
+	}
+}
 
-	            for (unsigned int i = 0; i < officialMatch->matchEvents.size(); i++)
-	            {
-	                std::string timeStamp = officialMatch->matchEvents.at(i).match_time;
-	                std::string message   = officialMatch->matchEvents.at(i).message;
+// Show the statistics of the official match in progress
+void LeagueOverseer::slashStats (int playerID, bz_BasePlayerRecord* /*playerData*/, bz_APIStringList *params)
+{
+	if (isOfficialMatch())
+	{
+	    int page = (params->size() > 0 && isInteger(params->get(0).c_str())) ? atoi(params->get(0).c_str()) : 1;
 
-	                bz_sendTextMessagef(BZ_SERVER, playerID, "  [%s] %s", timeStamp.c_str(), message.c_str());
-	            }
-	        }
-	        else
-	        {
-	            bz_sendTextMessage(BZ_SERVER, playerID, "Match data is not recorded for fun matches.");
-	        }
-	    }
-	    else
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "You do not have permission to use the /stats command.");
-	    }
+	    // The summary is kept up to date during the match, so we only need to format the requested page and
+	    // let the tick handler send it a few lines at a time
+	    std::vector<std::string> lines;
+	    officialMatch->summary.renderPage(page, TEAM_ONE, TEAM_TWO, lines);
+
+	    queueMessages(playerID, lines);
 	}
-	else if (command == "timelimt")
+	else
 	{
-	    if (isMatchInProgress())
-	    {
-	        bz_sendTextMessage(BZ_SERVER, playerID, "A match is already in progress, you cannot change the match duration now.");
-	        return true;
-	    }
+	    bz_sendTextMessage(BZ_SERVER, playerID, "Match data is not recorded for fun matches.");
+	}
+}
 
-	    if (params->size() != 1)
-	    {
-	        bz_sendTextMessagef (BZ_SERVER, playerID, "Usage: /timelimit <minutes>|show|reset");
-	        return true;
-	    }
+// Show, change or reset the duration of matches
+void LeagueOverseer::slashTimeLimit (int playerID, bz_BasePlayerRecord* /*playerData*/, bz_APIStringList *params)
+{
+	if (isMatchInProgress())
+	{
+	    bz_sendTextMessage(BZ_SERVER, playerID, "A match is already in progress, you cannot change the match duration now.");
+	    return;
+	}
 
-	    bool timeChanged = false;
-	    std::string commandOption = params->get(0).c_str();
+	if (params->size() != 1)
+	{
+	    bz_sendTextMessagef (BZ_SERVER, playerID, "Usage: /timelimit <minutes>|show|reset");
+	    return;
+	}
 
-	    if (commandOption == "show")
-	    {
-	        bz_sendTextMessagef(BZ_SERVER, playerID, "Match duration is set to %.0f minute(s)", (bz_getTimeLimit() / 60));
-	    }
-	    else if (commandOption == "reset")
-	    {
-	        resetTimeLimit();
-	        timeChanged = true;
-	    }
-	    else if (isInteger(commandOption))
-	    {
-	        bz_setTimeLimit(std::stoi(commandOption) * 60);
-	        timeChanged = true;
-	    }
+	bool timeChanged = false;
+	std::string commandOption = params->get(0).c_str();
 
-	    if (timeChanged)
-	    {
-	        bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Match duration set to %.0f minute(s) by %s", (bz_getTimeLimit() / 60), bz_getPlayerCallsign(playerID));
-	    }
+	if (commandOption == "show")
+	{
+	    bz_sendTextMessagef(BZ_SERVER, playerID, "Match duration is set to %.0f minute(s)", (bz_getTimeLimit() / 60));
+	}
+	else if (commandOption == "reset")
+	{
+	    resetTimeLimit();
+	    timeChanged = true;
+	}
+	else if (isInteger(commandOption))
+	{
+	    bz_setTimeLimit(std::stoi(commandOption) * 60);
+	    timeChanged = true;
 	}
 
-	return true;
+	if (timeChanged)
+	{
+	    bz_sendTextMessagef(BZ_SERVER, BZ_ALLUSERS, "Match duration set to %.0f minute(s) by %s", (bz_getTimeLimit() / 60), bz_getPlayerCallsign(playerID));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,472 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A soak test that loads the plug-in into the stub host in soak/ and plays thousands of official and fun matches
+// with players joining, leaving, substituting, chatting, capturing and using the slash commands. A server runs for
+// weeks, so whatever the plug-in holds on to has to stay the same size from one match to the next: every player
+// record and player list it borrows must be given back by the end of each match, and the heap may not grow once the
+// first matches have warmed up the caches. Any growth fails the test, as does a match that didn't play out the way
+// the plug-in reported it over its event bus.
+//
+//     Usage: LeagueOverseerSoak [-v] [matches]
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <malloc.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "bzfsAPI.h"
+#include "EventBus.h"
+#include "MatchSnapshot.h"
+#include "StubHost.h"
+
+extern "C" bz_Plugin* bz_GetPlugin (void);
+extern "C" void bz_FreePlugin (bz_Plugin* plugin);
+
+static const int    DEFAULT_MATCHES = 2000;
+static const int    WARM_UP_MATCHES = 50;        // Matches played before the heap is measured, so the caches have filled
+static const size_t HEAP_SLACK      = 64 * 1024; // Growth allowed for the allocator's own bookkeeping
+
+static const int LEAGUE_TEAMS     = 4;
+static const int TEAM_MEMBERS     = 5;           // Four play each match; a different one sits out every time
+static const int GUESTS           = 3;
+
+struct SoakPlayer
+{
+    std::string callsign,
+                bzID;
+    bool        league;
+};
+
+// What we expect the event bus to have told us, and what it did
+struct BusCounts
+{
+    int starts, ends, cancels, rollCalls;
+
+    BusCounts () : starts(0), ends(0), cancels(0), rollCalls(0) {}
+};
+
+static std::vector<SoakPlayer> leaguePlayers, guests;
+static SoakPlayer              mutedPlayer;
+static BusCounts               expected, reported;
+static std::string             pluginName;
+static int                     failures = 0;
+
+static void fail (const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "FAIL: ");
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+
+    failures++;
+}
+
+static size_t heapInUse (void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+#else
+    struct mallinfo info = mallinfo();
+#endif
+
+    return (size_t)info.uordblks + (size_t)info.hblkhd;
+}
+
+static void countBusEvent (const LosBusEvent &event, void* userData)
+{
+    BusCounts* counts = (BusCounts*)userData;
+
+    switch (event.type)
+    {
+        case LOS_EVENT_MATCH_START:  counts->starts++;                        break;
+        case LOS_EVENT_MATCH_END:    counts->ends++;                          break;
+        case LOS_EVENT_MATCH_CANCEL: counts->cancels++;                       break;
+        case LOS_EVENT_ROLL_CALL:    counts->rollCalls += (event.success);    break;
+        default:                                                              break;
+    }
+}
+
+static std::string teamName (int team)
+{
+    return "Soak Team " + std::to_string(team + 1);
+}
+
+static int joinPlayer (const SoakPlayer &player, bz_eTeamType team)
+{
+    std::vector<std::string> groups;
+
+    if (player.league)
+    {
+        groups.push_back("VERIFIED");
+    }
+
+    int playerID = stubHost.join(player.callsign, player.bzID, team, player.league, groups);
+
+    if (player.league)
+    {
+        stubHost.grant(playerID, "poll");
+    }
+
+    return playerID;
+}
+
+static void checkBorrowed (const char* when)
+{
+    if (stubHost.liveRecords() != 0)
+    {
+        fail("%d player record(s) were not freed %s", stubHost.liveRecords(), when);
+    }
+
+    if (stubHost.liveLists() != 0)
+    {
+        fail("%d player list(s) were not deleted %s", stubHost.liveLists(), when);
+    }
+
+    if (stubHost.pendingUrlJobs() != 0)
+    {
+        fail("%d URL job(s) were left unanswered %s", stubHost.pendingUrlJobs(), when);
+    }
+}
+
+// Play a single match from the first join to the last part. Two of the league's teams play on red and blue with a
+// guest and a muted league member watching; along the way the match is paused, a player subs out and back in, and
+// some matches are canceled or finished early. Every tenth official match starts with a player the league site gives
+// the wrong team name, which fails the first roll call.
+static void playMatch (int match)
+{
+    bool official = (match % 3 != 2),
+         misnamed = (official && match % 10 == 0),
+         cancel   = (official) ? (match % 7 == 3) : (match % 5 == 0),
+         finish   = (official && !cancel && match % 11 == 5);
+
+    int teamOne = match % LEAGUE_TEAMS,
+        teamTwo = (match + 1) % LEAGUE_TEAMS;
+
+    const SoakPlayer &transfer = leaguePlayers[teamOne * TEAM_MEMBERS + match % TEAM_MEMBERS];
+
+    if (misnamed)
+    {
+        stubHost.setLeagueTeam(transfer.bzID, "Soak Transfers");
+    }
+
+    std::vector<int> red, blue;
+
+    for (int i = 0; i < TEAM_MEMBERS - 1; i++)
+    {
+        red.push_back(joinPlayer(leaguePlayers[teamOne * TEAM_MEMBERS + (match + i) % TEAM_MEMBERS], eRedTeam));
+        blue.push_back(joinPlayer(leaguePlayers[teamTwo * TEAM_MEMBERS + (match + i) % TEAM_MEMBERS], eBlueTeam));
+    }
+
+    const SoakPlayer &substitute = leaguePlayers[teamTwo * TEAM_MEMBERS + (match + 3) % TEAM_MEMBERS];
+
+    int guest = joinPlayer(guests[match % GUESTS], eObservers),
+        muted = joinPlayer(mutedPlayer, eObservers),
+        leader = red[0];
+
+    stubHost.answerUrlJobs();
+
+    // The league site has the right name again, but the plug-in won't ask until the roll call fails
+    if (misnamed)
+    {
+        stubHost.setLeagueTeam(transfer.bzID, teamName(teamOne));
+    }
+
+    stubHost.grant(leader, "ban");
+    stubHost.grant(leader, "shutdownserver");
+
+    stubHost.slashCommand(leader, "/timelimit show");
+    stubHost.slashCommand(leader, (official) ? "/official" : "/fm");
+    stubHost.advance(11);
+
+    if (!bz_isCountDownActive())
+    {
+        fail("match %d did not start", match);
+        return;
+    }
+
+    expected.starts++;
+
+    for (int t = 0; bz_isCountDownActive(); t += 10)
+    {
+        if (t % 40 == 20)
+        {
+            stubHost.capture(red[(t / 40) % red.size()], eBlueTeam);
+            stubHost.grabFlag(red[1], 1);
+            stubHost.grabFlag(blue[0], 1);
+        }
+        else if (t % 40 == 0)
+        {
+            stubHost.capture(blue[(t / 40) % blue.size()], eRedTeam);
+        }
+
+        stubHost.kill(blue[t % blue.size()], red[(t / 10) % red.size()]);
+        stubHost.kill(red[(t / 10) % red.size()], BZ_SERVER);
+
+        stubHost.chat(red[1], BZ_ALLUSERS, eNoTeam, "gg");
+        stubHost.chat(guest, BZ_ALLUSERS, eNoTeam, "hello?");
+        stubHost.chat(guest, blue[0], eNoTeam, "psst");
+        stubHost.chat(muted, BZ_ALLUSERS, eNoTeam, "let me talk");
+        stubHost.spawn(guest);
+
+        if (t == 50)
+        {
+            stubHost.slashCommand(leader, "/pause");
+            stubHost.advance(20);
+            stubHost.slashCommand(red[1], "/resume");
+        }
+        else if (t == 100)
+        {
+            stubHost.slashCommand(leader, "/stats");
+            stubHost.slashCommand(blue[0], "/s 2");
+            stubHost.slashCommand(leader, "/showhidden");
+            stubHost.slashCommand(leader, "/lodbg grant_perm " + leaguePlayers[teamTwo * TEAM_MEMBERS + match % TEAM_MEMBERS].callsign + " poll");
+            stubHost.slashCommand(guest, "/official");
+            stubHost.slashCommand(blue[1], "/poll kick " + guests[match % GUESTS].callsign);
+            stubHost.slashCommand(blue[1], "/countdown pause");
+        }
+        else if (t == 110 && cancel)
+        {
+            stubHost.slashCommand(leader, "/cancel");
+        }
+        else if (t == 120)
+        {
+            stubHost.part(blue[3]);
+            stubHost.advance(5);
+            blue[3] = joinPlayer(substitute, eBlueTeam);
+        }
+        else if (t == 160)
+        {
+            char matchTime[16] = {0};
+            MatchSnapshot snapshot = MatchSnapshot();
+            snapshot.version = MATCH_SNAPSHOT_VERSION;
+
+            bz_callPluginGenericCallback(pluginName.c_str(), "GetMatchTime", matchTime);
+            bz_callPluginGenericCallback(pluginName.c_str(), "GetMatchSnapshot", &snapshot);
+            bz_callPluginGenericCallback(pluginName.c_str(), "IsOfficialMatch", NULL);
+        }
+        else if (t == 200 && finish)
+        {
+            stubHost.slashCommand(leader, "/finish");
+        }
+
+        stubHost.advance(10);
+        stubHost.answerUrlJobs();
+    }
+
+    (official && cancel) ? expected.cancels++ : expected.ends++;
+
+    // A failed roll call is retried a minute later, which is after a match that's being canceled has ended
+    if (official && !(misnamed && cancel))
+    {
+        expected.rollCalls++;
+    }
+
+    // Report the match, let everyone leave and wait for the plug-in to forget the players who left during the match
+    stubHost.advance(2);
+    stubHost.answerUrlJobs();
+
+    for (int playerID : red)  { stubHost.part(playerID); }
+    for (int playerID : blue) { stubHost.part(playerID); }
+
+    stubHost.part(guest);
+    stubHost.part(muted);
+
+    stubHost.advance(61);
+    stubHost.answerUrlJobs();
+
+    checkBorrowed(("after match " + std::to_string(match)).c_str());
+}
+
+static void removeDirectory (const std::string &path)
+{
+    DIR* dir = opendir(path.c_str());
+    struct dirent* entry;
+
+    while (dir && (entry = readdir(dir)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+        {
+            unlink((path + "/" + entry->d_name).c_str());
+        }
+    }
+
+    if (dir)
+    {
+        closedir(dir);
+    }
+
+    rmdir(path.c_str());
+}
+
+int main (int argc, char* argv[])
+{
+    int matches = DEFAULT_MATCHES;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-v") == 0)
+        {
+            stubHost.verbose = true;
+        }
+        else if (atoi(argv[i]) > 0)
+        {
+            matches = atoi(argv[i]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-v] [matches]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (matches <= WARM_UP_MATCHES)
+    {
+        fprintf(stderr, "At least %d matches are needed to warm up before the heap is measured.\n", WARM_UP_MATCHES + 1);
+        return 1;
+    }
+
+    // The configuration and the match timelines go in a scratch directory that's removed afterwards
+    std::string scratch = std::string((getenv("TMPDIR")) ? getenv("TMPDIR") : "/tmp") + "/LeagueOverseerSoak.XXXXXX";
+
+    if (!mkdtemp(&scratch[0]))
+    {
+        fprintf(stderr, "The scratch directory %s could not be created.\n", scratch.c_str());
+        return 1;
+    }
+
+    std::string configPath = scratch + "/LeagueOverseer.cfg";
+    std::ofstream config(configPath.c_str());
+
+    config << "[LeagueOverseer]\n"
+           << "  LEAGUE_OVERSEER_URL = http://localhost/soak\n"
+           << "  DEFAULT_TIME_LIMIT = 300\n"
+           << "  IGNORE_TIME_CHECKS = true\n"
+           << "  IN_GAME_DEBUG_ENABLED = true\n"
+           << "  MUTE_LIST_ENABLED = true\n"
+           << "  PC_PROTECTION_ENABLED = true\n"
+           << "  TIMELINE_DIRECTORY = " << scratch << "\n";
+    config.close();
+
+    for (int team = 0; team < LEAGUE_TEAMS; team++)
+    {
+        for (int member = 0; member < TEAM_MEMBERS; member++)
+        {
+            SoakPlayer player = { "Player " + std::to_string(team + 1) + "-" + std::to_string(member + 1), std::to_string(1000 + team * 10 + member), true };
+
+            leaguePlayers.push_back(player);
+            stubHost.setLeagueTeam(player.bzID, teamName(team));
+        }
+    }
+
+    for (int guest = 0; guest < GUESTS; guest++)
+    {
+        SoakPlayer player = { "Guest " + std::to_string(guest + 1), "", false };
+        guests.push_back(player);
+    }
+
+    mutedPlayer.callsign = "Loudmouth";
+    mutedPlayer.bzID     = "2001";
+    mutedPlayer.league   = true;
+
+    stubHost.setLeagueTeam(mutedPlayer.bzID, "");
+    stubHost.mute(mutedPlayer.bzID, true);
+
+    // Load the plug-in and listen to its event bus the way another plug-in would
+    bz_Plugin* plugin = bz_GetPlugin();
+    stubHost.load(plugin, configPath.c_str());
+    stubHost.answerUrlJobs();
+
+    pluginName = (bz_clipFieldExists("LeagueOverseer")) ? bz_getclipFieldString("LeagueOverseer") : "";
+
+    LosEventSubscription subscription = LosEventSubscription();
+    subscription.version  = LOS_EVENT_BUS_VERSION;
+    subscription.callback = countBusEvent;
+    subscription.userData = &reported;
+
+    if (bz_callPluginGenericCallback(pluginName.c_str(), "SubscribeMatchEvents", &subscription) == 0)
+    {
+        fail("the event bus subscription was refused");
+    }
+
+    size_t heapBaseline = 0, heapPeak = 0;
+    int    played = 0;
+
+    // Stop at the first match that fails; the rest would only repeat it
+    while (played < matches && !failures)
+    {
+        playMatch(played++);
+
+        if (played == WARM_UP_MATCHES)
+        {
+            heapBaseline = heapPeak = heapInUse();
+        }
+        else if (played > WARM_UP_MATCHES)
+        {
+            heapPeak = std::max(heapPeak, heapInUse());
+        }
+    }
+
+    size_t heapFinal = heapInUse();
+
+    printf("%d matches played; heap in use %zu bytes after warm-up, %zu at the end, %zu at the peak\n", played, heapBaseline, heapFinal, heapPeak);
+
+    if (played == matches && heapFinal > heapBaseline + HEAP_SLACK)
+    {
+        fail("the heap grew by %zu bytes after warming up", heapFinal - heapBaseline);
+    }
+
+    if (reported.starts != expected.starts || reported.ends != expected.ends || reported.cancels != expected.cancels || reported.rollCalls != expected.rollCalls)
+    {
+        fail("the event bus reported %d starts, %d ends, %d cancellations and %d roll calls; expected %d, %d, %d and %d",
+             reported.starts, reported.ends, reported.cancels, reported.rollCalls,
+             expected.starts, expected.ends, expected.cancels, expected.rollCalls);
+    }
+
+    bz_callPluginGenericCallback(pluginName.c_str(), "UnsubscribeMatchEvents", &subscription);
+
+    stubHost.unload();
+    bz_FreePlugin(plugin);
+
+    checkBorrowed("after unloading");
+
+    if (stubHost.registeredEvents() != 0 || stubHost.registeredCommands() != 0)
+    {
+        fail("%d event(s) and %d slash command(s) are still registered after unloading", stubHost.registeredEvents(), stubHost.registeredCommands());
+    }
+
+    removeDirectory(scratch);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d failure(s)\n", failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
\ No newline at end of file
@@ -17,30 +17,46 @@ League Overseer
 */
 
 #include <json/json.h>
+#include <memory>
 #include <string>
 
 #include "LeagueOverseer.h"
 #include "LeagueOverseer-Helpers.h"
 
+// Parsed JSON is reference counted by json-c, so we give up our reference once we're done with it
+struct JsonObjectDeleter
+{
+    void operator() (json_object *jobj) const { json_object_put(jobj); }
+};
+
 // We got a response from one of our URL jobs
 void LeagueOverseer::URLDone (const char* /*URL*/, const void* data, unsigned int /*size*/, bool /*complete*/)
 {
     // This variable will only be set to true for the duration of one URL job, so just set it back to false regardless
     MATCH_INFO_SENT = false;
 
+    TraceRecorder::Scope scope(tracer, "url_done");
+
     // Convert the data we get from the URL job to a std::string
-    std::string siteData = (const char*)(data);
+    std::string siteData = (data) ? (const char*)(data) : "";
     logMessage(pluginSettings.getVerboseLevel(), "debug", "URL Job returned: %s", siteData.c_str());
 
     // The returned data starts with a '{' and ends with a '}' so chances are it's JSON data
-    if (siteData.at(0) == '{' && siteData.at(siteData.length() - 1) == '}')
+    if (!siteData.empty() && siteData.at(0) == '{' && siteData.at(siteData.length() - 1) == '}')
     {
-        json_object* jobj = json_tokener_parse(siteData.c_str());
+        std::unique_ptr<json_object, JsonObjectDeleter> jobj(json_tokener_parse(siteData.c_str()));
         enum json_type type;
         std::string urlJobBZID = "", urlJobTeamName = "";
+        TeamNameMottoMap dumpedMottos;
+
+        if (!jobj)
+        {
+            logMessage(0, "warning", "The league site returned JSON data that could not be parsed.");
+            return;
+        }
 
         // Because our JSON information has a BZID and a team name, we need to loop through them to get the information
-        json_object_object_foreach(jobj, key, val)
+        json_object_object_foreach(jobj.get(), key, val)
         {
             // Get the type of object, we need to make sure we only handle strings because that's all we should be expecting
             type = json_object_get_type(val);
@@ -93,7 +109,7 @@ void LeagueOverseer::URLDone (const char* /*URL*/, const void* data, unsigned in
                                     for (std::vector<std::string>::const_iterator it = bzIDs.begin(); it != bzIDs.end(); ++it)
                                     {
                                         std::string bzID = std::string(*it);
-                                        teamMottos[bzID.c_str()] = teamName.c_str();
+                                        dumpedMottos[bzID.c_str()] = teamName.c_str();
 
                                         logMessage(pluginSettings.getVerboseLevel(), "debug", "BZID %s set to team %s.", bzID.c_str(), teamName.c_str());
                                     }
@@ -104,6 +120,47 @@ void LeagueOverseer::URLDone (const char* /*URL*/, const void* data, unsigned in
                 }
                 break;
 
+                // We're getting an object, which is an update to the league's mute list
+                case json_type_object:
+                {
+                    if (strcmp(key, "muteList") != 0)
+                    {
+                        break;
+                    }
+
+                    // The update looks like {"version": 12, "full": false, "muted": ["..."], "unmuted": ["..."]}
+                    std::vector<std::string> muted, unmuted;
+                    int  version = 0;
+                    bool full    = false;
+
+                    json_object_object_foreach(val, _key, _value)
+                    {
+                        if (strcmp(_key, "version") == 0)
+                        {
+                            version = json_object_get_int(_value);
+                        }
+                        else if (strcmp(_key, "full") == 0)
+                        {
+                            full = json_object_get_boolean(_value);
+                        }
+                        else if ((strcmp(_key, "muted") == 0 || strcmp(_key, "unmuted") == 0) && json_object_get_type(_value) == json_type_array)
+                        {
+                            std::vector<std::string> &bzIDs = (strcmp(_key, "muted") == 0) ? muted : unmuted;
+
+                            for (int i = 0; i < json_object_array_length(_value); i++)
+                            {
+                                bzIDs.push_back(json_object_get_string(json_object_array_get_idx(_value, i)));
+                            }
+                        }
+                    }
+
+                    muteList.apply(version, full, muted, unmuted);
+
+                    logMessage(pluginSettings.getVerboseLevel(), "debug", "Mute list updated to version %d (%d muted, %d unmuted, %d total).",
+                        version, (int)muted.size(), (int)unmuted.size(), (int)muteList.size());
+                }
+                break;
+
                 // We've found a JSON string, which means it's only a single team name and bzid so handle it accordingly
                 case json_type_string:
                 {
@@ -125,6 +182,37 @@ void LeagueOverseer::URLDone (const char* /*URL*/, const void* data, unsigned in
             }
         }
 
+        if (!dumpedMottos.empty())
+        {
+            if (teamCache.isWriter())
+            {
+                // Share the dump with the other servers on this host; the names we looked up ourselves are out of date now
+                if (teamCache.publish(dumpedMottos))
+                {
+                    teamMottos.clear();
+
+                    logMessage(pluginSettings.getVerboseLevel(), "debug", "Team name database shared with the other servers on this host.");
+                }
+                else
+                {
+                    // Keep our own copy so the names that didn't fit are still found here
+                    logMessage(0, "warning", "The team name database is too large to be shared in full.");
+
+                    for (auto &motto : dumpedMottos)
+                    {
+                        teamMottos[motto.first] = motto.second;
+                    }
+                }
+            }
+            else
+            {
+                for (auto &motto : dumpedMottos)
+                {
+                    teamMottos[motto.first] = motto.second;
+                }
+            }
+        }
+
         // We have both a BZID and a team name so let's update our team motto map
         if (urlJobBZID != "")
         {
@@ -133,12 +221,16 @@ void LeagueOverseer::URLDone (const char* /*URL*/, const void* data, unsigned in
             logMessage(pluginSettings.getVerboseLevel(), "debug", "Motto saved for BZID %s.", urlJobBZID.c_str());
 
             // If the team name is equal to an empty string that means a player is teamless and if they are in our motto
-            // map, that means they recently left a team so remove their entry in the map
-            if (urlJobTeamName == "" && teamMottos.count(urlJobBZID))
+            // map, that means they recently left a team so remove their entry in the map. The empty entry is kept when
+            // the team names are shared so the stale name in the shared table is overridden.
+            if (urlJobTeamName == "" && teamMottos.count(urlJobBZID) && !teamCache.attached())
             {
                 teamMottos.erase(urlJobBZID);
             }
         }
+
+        metrics.setGauge(METRIC_GAUGE_TEAM_MOTTOS, teamMottos.size());
+        metrics.setGauge(METRIC_GAUGE_MUTED_PLAYERS, muteList.size());
     }
 }
 
@@ -147,6 +239,8 @@ void LeagueOverseer::URLTimeout (const char* /*URL*/, int /*errorCode*/)
 {
     logMessage(0, "warning", "The request to the league site has timed out.");
 
+    TraceRecorder::Scope scope(tracer, "url_timeout");
+
     if (MATCH_INFO_SENT)
     {
         MATCH_INFO_SENT = false;
@@ -161,6 +255,8 @@ void LeagueOverseer::URLError (const char* /*URL*/, int errorCode, const char *e
     logMessage(0, "error", "Match report failed with the following error:");
     logMessage(0, "error", "Error code: %i - %s", errorCode, errorString);
 
+    TraceRecorder::Scope scope(tracer, "url_error");
+
     if (MATCH_INFO_SENT)
     {
         MATCH_INFO_SENT = false;
@@ -16,11 +16,32 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <deque>
+#include <map>
 #include <memory>
+#include <set>
 
 #include "bzfsAPI.h"
 
+#include "ChatPolicy.h"
+#include "ConfigWatcher.h"
 #include "ConfigurationOptions.h"
+#include "EventBus.h"
+#include "JsonWriter.h"
+#include "MatchClock.h"
+#include "MatchSnapshot.h"
+#include "MatchSummary.h"
+#include "MatchTimeline.h"
+#include "Metrics.h"
+#include "MuteList.h"
+#include "PermissionManager.h"
+#include "RateLimiter.h"
+#include "ReplayArchiver.h"
+#include "ReplayIndex.h"
+#include "ReplayRetention.h"
+#include "SharedTeamCache.h"
+#include "TimerWheel.h"
+#include "TraceRecorder.h"
 #include "UrlQuery.h"
 
 class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, public bz_BaseURLHandler
@@ -54,10 +75,13 @@ class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, pu
 
             double       lastActive;
 
+            TimerWheel::TimerID expiry;     // The timer that removes the player from the list once they've been gone a minute
+
             Player (std::string _bzID, bz_eTeamType _lastActiveTeam, double _lastActive) :
                 bzID(_bzID),
                 lastActiveTeam(_lastActiveTeam),
-                lastActive(_lastActive)
+                lastActive(_lastActive),
+                expiry(0)
             {}
         };
 
@@ -125,6 +149,9 @@ class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, pu
             // All of the events that occur in this match
             std::vector<MatchEvent> matchEvents;
 
+            // A summary of the match that is kept up to date as events happen; used by the /stats command
+            MatchSummary summary;
+
             // Set the default values for this struct
             OfficialMatch () :
                 playersRecorded(false),
@@ -141,6 +168,18 @@ class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, pu
         };
 
 
+        // The slash commands we support are dispatched through a table of these, see LeagueOverseer-SlashCommands.cpp
+        typedef void (LeagueOverseer::*SlashCommandHandler)(int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params);
+
+        struct SlashCommandEntry
+        {
+            const char*         name;
+            SlashCommandHandler handler;
+            const char*         permission; // The BZFS permission needed on top of being a league member, or NULL
+            bool                throttled;  // Whether the command counts towards the player's command rate limit
+        };
+
+
         ///
         /// Custom functions defined
         ///
@@ -152,24 +191,63 @@ class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, pu
         virtual std::string          getPlayerTeamNameByBZID (std::string bzID),
                                      getPlayerTeamNameByID (int playerID),
                                      buildBZIDString (bz_eTeamType team),
-                                     getMatchTime (void);
+                                     getBZIDByCallsign (std::string callsign),
+                                     getBZIDByID (int playerID);
+
+        virtual const char*          getMatchTime (char *buffer, size_t size);
 
         virtual bool                 isOfficialMatchInProgress (void),
                                      playerAlreadyJoined (std::string bzID),
                                      isMatchInProgress (void),
                                      isOfficialMatch (void),
-                                     isLeagueMember (int playerID);
+                                     isLeagueMember (int playerID),
+                                     reloadConfiguration (void);
 
         virtual void                 validateTeamName (bool &invalidate, bool &teamError, MatchParticipant currentPlayer, std::string &teamName, bz_eTeamType team),
+                                     collectArchivedReplays (bool unloading = false),
+                                     collectEvictedReplays (void),
+                                     startMetrics (void),
+                                     startReplayRetention (void),
+                                     processRollCall (void),
+                                     scheduleRollCall (void),
+                                     rememberActivePlayer (std::string bzID, bz_eTeamType team),
+                                     clearActivePlayers (void),
+                                     checkTeamCache (void),
+                                     buildFlagTeamTable (void),
+                                     updateChatPolicy (bool matchInProgress),
+                                     requestMuteList (void),
+                                     saveReplayIndex (std::string replayName, const std::string &index),
+                                     queueMessages (int playerID, const std::vector<std::string> &lines),
+                                     sendQueuedMessages (void),
                                      removePlayerInfo (std::string bzID, std::string callsign),
                                      storePlayerInfo (int playerID, std::string bzID, std::string callsign),
                                      requestTeamName (std::string callsign, std::string bzID),
                                      requestTeamName (bz_eTeamType team),
                                      setLeagueMember (int playerID),
+                                     publishMatchSnapshot (void),
+                                     publishMatchSnapshot (MatchSnapshotState state),
                                      resetTimeLimit (void);
 
         virtual int                  getMatchProgress (void);
 
+        // The handlers of our slash commands
+        void                         slashCancel (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashDebug (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashFinish (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashFunMatch (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashLeagueOverseer (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashOfficial (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashPause (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashResume (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashShowHidden (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashSpawn (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashStats (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     slashTimeLimit (int playerID, bz_BasePlayerRecord *playerData, bz_APIStringList *params),
+                                     registerSlashCommands (void),
+                                     removeSlashCommands (void);
+
+        virtual LosBusEvent          createBusEvent (LosBusEventType type, int playerID = -1);
+
 
         ///
         /// All of the instance variables used throughout the plug-in
@@ -179,42 +257,111 @@ class LeagueOverseer : public bz_Plugin, public bz_CustomSlashCommandHandler, pu
                      MATCH_INFO_SENT,        // Whether or not the information returned by a URL job pertains to a match report
                      RECORDING;              // Whether or not we are recording a match
 
-        double       LAST_CAP;               // The event time of the last flag capture
-
-        time_t       MATCH_START,            // The timestamp of when a match was started in order to calculate the timer
-                     MATCH_PAUSED;           // If the match is paused, it will be stored here in order to update MATCH_START appropriately for the timer
-
         std::string  CONFIG_PATH,            // The location of the configuration file so we can reload it if needed
                      MAP_NAME;               // The name of the map that is currently be played if it's a rotation league (i.e. OpenLeague uses multiple maps)
 
-        bz_eTeamType CAP_VICTIM_TEAM,        // The team who had their flag captured most recently
-                     CAP_WINNER_TEAM,        // The team who captured the flag most recently
-                     TEAM_ONE,               // Because we're serving more than just GU league, we need to support different colors therefore, call the teams
+        bz_eTeamType TEAM_ONE,               // Because we're serving more than just GU league, we need to support different colors therefore, call the teams
                      TEAM_TWO;               //     ONE and TWO
 
         int          PC_PROTECTION_DELAY;    // The delay (in seconds) of how long the PC protection will be in effect
 
+        // The team each flag belongs to indexed by flag ID, and the server time until which each team's flag is protected
+        // after being captured; both are indexed directly so a flag grab never has to compare flag abbreviations
+        std::vector<bz_eTeamType> flagTeams;
+        double                    pcProtectionExpiry[ePurpleTeam + 1];
+
         UrlQuery     TeamUrlRepo,
                      MatchUrlRepo;
 
+        // The connection to the daemon that sends our requests to the league site, if the server owner runs one
+        ReportRelay  reportRelay;
+
         ConfigurationOptions pluginSettings;
 
+        // Notices when the configuration file or the mapchange file is edited so the changes can be applied live
+        ConfigWatcher        configWatcher;
+
+        // What non-league members may say given the current configuration and match state, along with the message
+        // they're sent when they may not
+        ChatPolicy               chatPolicy;
+        std::vector<std::string> noTalkMessage;
+
+        // The players the league has muted, the numeric BZID of the player in each slot so the chat handler can check
+        // it without fetching a player record, and when we'll next ask the league site for changes to the list
+        MuteList     muteList;
+        uint32_t     playerBZIDs[256];
+        time_t       nextMuteListRefresh;
+
+        // How often each player may be sent denial notices or run the expensive slash commands
+        RateLimiter  rateLimiter;
+
+        // The permissions the current match state takes away from players and who they were actually taken from
+        PermissionManager permissionManager;
+
+        // The counters and gauges a background thread writes to the metrics file for node_exporter
+        Metrics      metrics;
+
+        // The spans of work recorded while '/lodbg trace' is running
+        TraceRecorder tracer;
+
+        // The work scheduled for later, which the tick handler advances, and the timer of the next roll call if one is due
+        TimerWheel          timers;
+        TimerWheel::TimerID rollCallTimer;
+
+        // The clock of the match in progress, which keeps track of the time spent paused
+        MatchClock   matchClock;
+
+        // The writer used to serialize match events; it's reset before each use so its buffer is reused
+        JsonWriter eventJson;
+
+        // The latest copy of the match state that is handed out to other plug-ins through 'GetMatchSnapshot'
+        MatchSnapshotSlot matchSnapshot;
+
+        // The plug-ins that have subscribed to our match events through 'SubscribeMatchEvents'
+        EventBus eventBus;
+
+        // The binary timeline of the official match in progress, if the server owner wants one
+        MatchTimeline matchTimeline;
+
+        // The background worker that compresses and archives replays after they're saved
+        ReplayArchiver replayArchiver;
+
+        // The background worker that removes the oldest replays once the fun or official budget has been exceeded
+        ReplayRetention replayRetention;
+
+        // The events that happened while the current match was being recorded, saved next to the replay
+        ReplayIndex replayIndex;
+
+        // Match reports waiting on their replay to be archived so the replay's hash can be reported, stored as
+        // <archive job ID, match report>
+        std::map<int, UrlQuery> pendingMatchReports;
+
         // Player database storing BZIDs and callsigns without having to loop through the entire playerlist each time
         std::map<std::string, int> BZID_MAP;
         std::map<std::string, int> CALLSIGN_MAP;
 
-        // The slash commands that are supported and used by this plug-in
-        std::vector<std::string> SLASH_COMMANDS;
-
         // The vector that is storing all of the active players
         std::vector<Player> activePlayerList;
 
+        // Long outputs are queued per player and sent a few lines each tick so we don't flood anyone in a single tick
+        std::map<int, std::deque<std::string>> queuedMessages;
+
+        // The team names shared with the other servers on this host, if the server owner has enabled it
+        SharedTeamCache teamCache;
+        time_t          nextTeamCacheCheck;
+
         // This is the only pointer of the struct for the official match that we will be using. If this
         // variable is set to NULL, that means that there is currently no official match occurring.
         std::shared_ptr<OfficialMatch> officialMatch;
 
         // We will be using a map to handle the team name mottos in the format of
-        // <BZID, Team Name>
+        // <BZID, Team Name>. When the team names are shared with other servers, this map only holds the
+        // names we've looked up ourselves since the last dump and they take precedence over the shared table.
         typedef std::map<std::string, std::string> TeamNameMottoMap;
         TeamNameMottoMap teamMottos;
+
+        // The names we last found in the shared table, for when it's busy being replaced, and the BZIDs that were
+        // looked up while it was busy and are checked again on the next tick
+        TeamNameMottoMap      sharedTeamMottos;
+        std::set<std::string> busyTeamLookups;
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <cstdio>
+
+#include "MatchClock.h"
+
+MatchClock::MatchClock () :
+    startedAt(0),
+    pausedAt(0),
+    pausedFor(0),
+    duration(0),
+    started(false),
+    paused(false)
+{}
+
+// Start the clock for a match lasting the given number of seconds
+void MatchClock::start (double now, double _duration)
+{
+    startedAt = now;
+    pausedAt  = 0;
+    pausedFor = 0;
+    duration  = _duration;
+    started   = true;
+    paused    = false;
+}
+
+void MatchClock::pause (double now)
+{
+    if (!started || paused)
+    {
+        return;
+    }
+
+    pausedAt = now;
+    paused   = true;
+}
+
+// Start the clock again; returns how many seconds the match was paused for
+double MatchClock::resume (double now)
+{
+    if (!started || !paused)
+    {
+        return 0;
+    }
+
+    double timePaused = now - pausedAt;
+
+    pausedFor += timePaused;
+    paused     = false;
+
+    return timePaused;
+}
+
+bool MatchClock::isPaused (void) const
+{
+    return paused;
+}
+
+// The number of seconds the match has been played, not counting pauses, or -1 if no match has been started
+double MatchClock::elapsed (double now) const
+{
+    if (!started)
+    {
+        return -1;
+    }
+
+    return ((paused) ? pausedAt : now) - startedAt - pausedFor;
+}
+
+double MatchClock::remaining (double now) const
+{
+    if (!started)
+    {
+        return 0;
+    }
+
+    double timeLeft = duration - elapsed(now);
+
+    return (timeLeft > 0) ? timeLeft : 0;
+}
+
+// Write the time remaining as MM:SS into the buffer and return it. The seconds are rounded up so a match shows its
+// full length when it starts and only shows 00:00 once it's over.
+const char* MatchClock::format (double now, char *buffer, size_t size) const
+{
+    if (!started)
+    {
+        snprintf(buffer, size, "-00:00");
+        return buffer;
+    }
+
+    int timeLeft = (int)ceil(remaining(now));
+
+    snprintf(buffer, size, "%02d:%02d", timeLeft / 60, timeLeft % 60);
+
+    return buffer;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MATCH_CLOCK_H__
+#define __MATCH_CLOCK_H__
+
+#include <cstddef>
+
+// The size of a buffer that can hold any time formatted by MatchClock::format()
+#define MATCH_CLOCK_BUFFER_SIZE 16
+
+// The clock of the match in progress, driven by the BZFS server time (bz_getCurrentTime()) so it has sub-millisecond
+// resolution and isn't affected by changes to the wall clock. Time spent paused is tracked exactly and left out of the
+// match's progress.
+class MatchClock
+{
+    public:
+        MatchClock ();
+
+        void   start     (double now, double duration);
+        void   pause     (double now);
+        double resume    (double now);
+
+        bool   isPaused  (void) const;
+        double elapsed   (double now) const;
+        double remaining (double now) const;
+
+        const char* format (double now, char *buffer, size_t size) const;
+
+    private:
+        double startedAt,
+               pausedAt,
+               pausedFor,
+               duration;
+
+        bool   started,
+               paused;
+};
+
+#endif
\ No newline at end of file
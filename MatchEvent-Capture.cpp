@@ -16,11 +16,13 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <json/json.h>
-
 #include "MatchEvent-Capture.h"
 
-CaptureMatchEvent::CaptureMatchEvent ()
+CaptureMatchEvent::CaptureMatchEvent () :
+    teamID(-1),
+    cappedTeamID(-1),
+    teamOneScore(0),
+    teamTwoScore(0)
 {
     setEventType(CAPTURE);
 }
@@ -32,6 +34,22 @@ CaptureMatchEvent& CaptureMatchEvent::setTeamID (int _teamID)
     return *this;
 }
 
+CaptureMatchEvent& CaptureMatchEvent::setCappedTeamID (int _cappedTeamID)
+{
+    cappedTeamID = _cappedTeamID;
+
+    return *this;
+}
+
+// The scores of the two teams playing after the capture
+CaptureMatchEvent& CaptureMatchEvent::setScore (int _teamOneScore, int _teamTwoScore)
+{
+    teamOneScore = _teamOneScore;
+    teamTwoScore = _teamTwoScore;
+
+    return *this;
+}
+
 CaptureMatchEvent& CaptureMatchEvent::setTime (std::string _time)
 {
     matchTime = _time;
@@ -46,17 +64,9 @@ CaptureMatchEvent& CaptureMatchEvent::setBZID (std::string _bzID)
     return *this;
 }
 
-CaptureMatchEvent& CaptureMatchEvent::save (void)
+CaptureMatchEvent& CaptureMatchEvent::setCallsign (std::string _callsign)
 {
-    json_object *jMatchTime = json_object_new_string(matchTime.c_str());
-    json_object *jTeamID    = json_object_new_int(teamID);
-    json_object *jBZID      = json_object_new_string(bzID.c_str());
-
-    json_object_object_add(jsonData, "match-time", jMatchTime);
-    json_object_object_add(jsonData, "team-id", jTeamID);
-    json_object_object_add(jsonData, "bzid", jBZID);
-
-    json_object_object_add(jsonObj, "data", jsonData);
+    callsign = _callsign;
 
     return *this;
 }
\ No newline at end of file
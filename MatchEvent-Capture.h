@@ -28,16 +28,36 @@ class CaptureMatchEvent : public MatchEvent<CaptureMatchEvent>
     public:
         CaptureMatchEvent ();
 
-        CaptureMatchEvent& setTeamID (int _teamID);
-        CaptureMatchEvent& setTime   (std::string _time);
-        CaptureMatchEvent& setBZID   (std::string _bzID);
-        CaptureMatchEvent& save      (void);
+        CaptureMatchEvent& setTeamID       (int _teamID);
+        CaptureMatchEvent& setCappedTeamID (int _cappedTeamID);
+        CaptureMatchEvent& setScore        (int _teamOneScore, int _teamTwoScore);
+        CaptureMatchEvent& setTime         (std::string _time);
+        CaptureMatchEvent& setBZID         (std::string _bzID);
+        CaptureMatchEvent& setCallsign     (std::string _callsign);
 
     private:
-        int         teamID;
+        friend class MatchEvent<CaptureMatchEvent>;
+
+        int         teamID,
+                    cappedTeamID,
+                    teamOneScore,
+                    teamTwoScore;
 
         std::string matchTime,
-                    bzID;
+                    bzID,
+                    callsign;
+
+        template<class Visitor>
+        void schema (Visitor &field)
+        {
+            field("match-time",     matchTime);
+            field("bzid",           bzID,         FIELD_BZID);
+            field("callsign",       callsign,     FIELD_SHOWN);
+            field("team-id",        teamID,       FIELD_TEAM);
+            field("capped-team-id", cappedTeamID, FIELD_OTHER_TEAM);
+            field("team-one-score", teamOneScore, FIELD_VALUE_ONE);
+            field("team-two-score", teamTwoScore, FIELD_VALUE_TWO);
+        }
 };
 
 #endif
\ No newline at end of file
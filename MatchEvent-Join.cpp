@@ -16,14 +16,15 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <json/json.h>
-
 #include "bzfsAPI.h"
 #include "MatchEvent-Join.h"
 
-JoinMatchEvent::JoinMatchEvent ()
+JoinMatchEvent::JoinMatchEvent () :
+    verified(false),
+    teamID(-1)
 {
     timestamp = getCurrentTimeStamp();
+    server    = bz_getPublicAddr().c_str();
 
     setEventType(PLAYER_JOIN);
 }
@@ -56,23 +57,9 @@ JoinMatchEvent& JoinMatchEvent::setBZID (std::string _bzID)
     return *this;
 }
 
-JoinMatchEvent& JoinMatchEvent::save (void)
+JoinMatchEvent& JoinMatchEvent::setTeamID (int _teamID)
 {
-    json_object *jServerAddr = json_object_new_string(bz_getPublicAddr().c_str());
-    json_object *jIpAddress  = json_object_new_string(ipAddress.c_str());
-    json_object *jTimestamp  = json_object_new_string(timestamp.c_str());
-    json_object *jCallsign   = json_object_new_string(callsign.c_str());
-    json_object *jVerified   = json_object_new_boolean(verified);
-    json_object *jBZID       = json_object_new_string(bzID.c_str());
-
-    json_object_object_add(jsonData, "timestamp", jTimestamp);
-    json_object_object_add(jsonData, "callsign", jCallsign);
-    json_object_object_add(jsonData, "verified", jVerified);
-    json_object_object_add(jsonData, "server", jServerAddr);
-    json_object_object_add(jsonData, "bzid", jBZID);
-    json_object_object_add(jsonData, "ip", jIpAddress);
-
-    json_object_object_add(jsonObj, "data", jsonData);
+    teamID = _teamID;
 
     return *this;
 }
\ No newline at end of file
@@ -32,15 +32,32 @@ class JoinMatchEvent : public MatchEvent<JoinMatchEvent>
         JoinMatchEvent& setCallsign  (std::string _callsign);
         JoinMatchEvent& setVerified  (bool _verified);
         JoinMatchEvent& setBZID      (std::string _bzID);
-        JoinMatchEvent& save         (void);
+        JoinMatchEvent& setTeamID    (int _teamID);
 
     private:
+        friend class MatchEvent<JoinMatchEvent>;
+
         bool        verified;
 
+        int         teamID;
+
         std::string ipAddress,
                     timestamp,
                     callsign,
+                    server,
                     bzID;
+
+        template<class Visitor>
+        void schema (Visitor &field)
+        {
+            field("timestamp", timestamp);
+            field("callsign",  callsign,  FIELD_SHOWN);
+            field("verified",  verified);
+            field("server",    server);
+            field("bzid",      bzID,      FIELD_BZID);
+            field("team-id",   teamID,    FIELD_TEAM);
+            field("ip",        ipAddress);
+        }
 };
 
 #endif
\ No newline at end of file
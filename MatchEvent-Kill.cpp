@@ -16,11 +16,12 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <json/json.h>
-
 #include "MatchEvent-Kill.h"
 
-KillMatchEvent::KillMatchEvent ()
+KillMatchEvent::KillMatchEvent () :
+    killerTeamID(-1),
+    victimTeamID(-1),
+    shotID(-1)
 {
     setEventType(PLAYER_KILL);
 }
@@ -39,24 +40,30 @@ KillMatchEvent& KillMatchEvent::setVictim (std::string _bzID)
     return *this;
 }
 
-KillMatchEvent& KillMatchEvent::setTime (std::string _matchTime)
+KillMatchEvent& KillMatchEvent::setKillerTeamID (int _teamID)
 {
-    matchTime = _matchTime;
+    killerTeamID = _teamID;
 
     return *this;
 }
 
-KillMatchEvent& KillMatchEvent::save (void)
+KillMatchEvent& KillMatchEvent::setVictimTeamID (int _teamID)
 {
-    json_object *jKillerBZID = json_object_new_string(killerBZID.c_str());
-    json_object *jVictimBZID = json_object_new_string(victimBZID.c_str());
-    json_object *jMatchTime  = json_object_new_string(matchTime.c_str());
+    victimTeamID = _teamID;
 
-    json_object_object_add(jsonData, "killer", jKillerBZID);
-    json_object_object_add(jsonData, "victim", jVictimBZID);
-    json_object_object_add(jsonData, "match-time", jMatchTime);
+    return *this;
+}
+
+KillMatchEvent& KillMatchEvent::setShotID (int _shotID)
+{
+    shotID = _shotID;
 
-    json_object_object_add(jsonObj, "data", jsonData);
+    return *this;
+}
+
+KillMatchEvent& KillMatchEvent::setTime (std::string _matchTime)
+{
+    matchTime = _matchTime;
 
     return *this;
 }
\ No newline at end of file
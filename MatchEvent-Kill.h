@@ -26,15 +26,34 @@ class KillMatchEvent : public MatchEvent<KillMatchEvent>
     public:
         KillMatchEvent ();
 
-        KillMatchEvent& setKiller (std::string _bzID);
-        KillMatchEvent& setVictim (std::string _bzID);
-        KillMatchEvent& setTime   (std::string _matchTime);
-        KillMatchEvent& save      (void);
+        KillMatchEvent& setKiller       (std::string _bzID);
+        KillMatchEvent& setVictim       (std::string _bzID);
+        KillMatchEvent& setKillerTeamID (int _teamID);
+        KillMatchEvent& setVictimTeamID (int _teamID);
+        KillMatchEvent& setShotID       (int _shotID);
+        KillMatchEvent& setTime         (std::string _matchTime);
 
     private:
+        friend class MatchEvent<KillMatchEvent>;
+
+        int         killerTeamID,
+                    victimTeamID,
+                    shotID;
+
         std::string killerBZID,
                     victimBZID,
                     matchTime;
+
+        template<class Visitor>
+        void schema (Visitor &field)
+        {
+            field("killer",         killerBZID,   FIELD_OTHER_BZID);
+            field("victim",         victimBZID,   FIELD_BZID);
+            field("killer-team-id", killerTeamID, FIELD_OTHER_TEAM);
+            field("victim-team-id", victimTeamID, FIELD_TEAM);
+            field("shot-id",        shotID,       FIELD_VALUE_ONE);
+            field("match-time",     matchTime);
+        }
 };
 
 #endif
\ No newline at end of file
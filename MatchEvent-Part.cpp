@@ -16,13 +16,13 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <json/json.h>
-
 #include "MatchEvent-Part.h"
 
-PartMatchEvent::PartMatchEvent ()
+PartMatchEvent::PartMatchEvent () :
+    teamID(-1)
 {
     timestamp = getCurrentTimeStamp();
+    server    = bz_getPublicAddr().c_str();
 
     setEventType(PLAYER_PART);
 }
@@ -34,17 +34,9 @@ PartMatchEvent& PartMatchEvent::setBZID (std::string _bzID)
     return *this;
 }
 
-PartMatchEvent& PartMatchEvent::save (void)
+PartMatchEvent& PartMatchEvent::setTeamID (int _teamID)
 {
-    json_object *jServerAddr = json_object_new_string(bz_getPublicAddr().c_str());
-    json_object *jTimestamp  = json_object_new_string(timestamp.c_str());
-    json_object *jBZID       = json_object_new_string(bzID.c_str());
-
-    json_object_object_add(jsonData, "timestamp", jTimestamp);
-    json_object_object_add(jsonData, "server", jServerAddr);
-    json_object_object_add(jsonData, "bzid", jBZID);
-
-    json_object_object_add(jsonObj, "data", jsonData);
+    teamID = _teamID;
 
     return *this;
 }
\ No newline at end of file
@@ -28,12 +28,26 @@ class PartMatchEvent : public MatchEvent<PartMatchEvent>
     public:
         PartMatchEvent ();
 
-        PartMatchEvent& setBZID (std::string _bzID);
-        PartMatchEvent& save    (void);
+        PartMatchEvent& setBZID   (std::string _bzID);
+        PartMatchEvent& setTeamID (int _teamID);
 
     private:
+        friend class MatchEvent<PartMatchEvent>;
+
+        int         teamID;
+
         std::string timestamp,
+                    server,
                     bzID;
+
+        template<class Visitor>
+        void schema (Visitor &field)
+        {
+            field("timestamp", timestamp);
+            field("server",    server);
+            field("bzid",      bzID,   FIELD_BZID);
+            field("team-id",   teamID, FIELD_TEAM);
+        }
 };
 
 #endif
\ No newline at end of file
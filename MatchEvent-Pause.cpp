@@ -0,0 +1,55 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MatchEvent-Pause.h"
+
+PauseMatchEvent::PauseMatchEvent ()
+{
+    setEventType(MATCH_PAUSE);
+}
+
+PauseMatchEvent& PauseMatchEvent::setPaused (void)
+{
+    return setEventType(MATCH_PAUSE);
+}
+
+PauseMatchEvent& PauseMatchEvent::setResumed (void)
+{
+    return setEventType(MATCH_RESUME);
+}
+
+PauseMatchEvent& PauseMatchEvent::setTime (std::string _matchTime)
+{
+    matchTime = _matchTime;
+
+    return *this;
+}
+
+PauseMatchEvent& PauseMatchEvent::setBZID (std::string _bzID)
+{
+    bzID = _bzID;
+
+    return *this;
+}
+
+PauseMatchEvent& PauseMatchEvent::setCallsign (std::string _callsign)
+{
+    callsign = _callsign;
+
+    return *this;
+}
\ No newline at end of file
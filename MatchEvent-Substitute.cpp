@@ -16,8 +16,6 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <json/json.h>
-
 #include "MatchEvent-Substitute.h"
 
 SubMatchEvent::SubMatchEvent ()
@@ -57,22 +55,5 @@ SubMatchEvent& SubMatchEvent::setBZID (std::string _bzID)
 {
     bzID = _bzID;
 
-    return *this;
-}
-
-SubMatchEvent& SubMatchEvent::save (void)
-{
-    json_object *jMatchTime = json_object_new_string(matchTime.c_str());
-    json_object *jAction    = json_object_new_string(action.c_str());
-    json_object *jTeamID    = json_object_new_int(teamID);
-    json_object *jBZID      = json_object_new_string(bzID.c_str());
-
-    json_object_object_add(jsonData, "team-id", jTeamID);
-    json_object_object_add(jsonData, "action", jAction);
-    json_object_object_add(jsonData, "match-time", jMatchTime);
-    json_object_object_add(jsonData, "bzid", jBZID);
-
-    json_object_object_add(jsonObj, "data", jsonData);
-
     return *this;
 }
\ No newline at end of file
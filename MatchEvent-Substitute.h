@@ -33,14 +33,24 @@ class SubMatchEvent : public MatchEvent<SubMatchEvent>
         SubMatchEvent& setGoingIn   (void);
         SubMatchEvent& setTeamID    (int _teamID);
         SubMatchEvent& setBZID      (std::string _bzID);
-        SubMatchEvent& save         (void);
 
     private:
+        friend class MatchEvent<SubMatchEvent>;
+
         int         teamID;
 
         std::string matchTime,
                     action,
                     bzID;
+
+        template<class Visitor>
+        void schema (Visitor &field)
+        {
+            field("team-id",    teamID, FIELD_TEAM);
+            field("action",     action, FIELD_SHOWN);
+            field("match-time", matchTime);
+            field("bzid",       bzID,   FIELD_BZID);
+        }
 };
 
 #endif
\ No newline at end of file
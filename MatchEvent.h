@@ -19,9 +19,169 @@ League Overseer
 #ifndef __MATCH_EVENT_H__
 #define __MATCH_EVENT_H__
 
-#include <json/json.h>
+#include <cstring>
+#include <string>
 
+#include "JsonWriter.h"
 #include "LeagueOverseer-Helpers.h"
+#include "MatchTimeline.h"
+
+///
+/// Field encoders
+///
+/// Every MatchEvent subclass describes its fields exactly once in a `schema()` member template which hands each
+/// field's key, value and role to a visitor. The encoders below are the visitors; because the schema is a template,
+/// each encoder is instantiated per event type and the compiler inlines the whole serialization with no runtime
+/// lookups. The role is a constant at every call, so the switches on it are folded away as well.
+///
+
+// What a field is used for besides the JSON report, which gets every field
+enum MatchEventField
+{
+    FIELD_REPORTED,     // Only reported to the league site
+    FIELD_SHOWN,        // Also shown by /stats
+    FIELD_BZID,         // The player the timeline record is about
+    FIELD_OTHER_BZID,   // The other player of the timeline record, e.g. the killer
+    FIELD_TEAM,         // The team of the timeline record; shown by /stats
+    FIELD_OTHER_TEAM,   // The other team of the timeline record; shown by /stats
+    FIELD_VALUE_ONE,    // The first value of the timeline record; shown by /stats
+    FIELD_VALUE_TWO     // The second value of the timeline record; shown by /stats
+};
+
+// Write each field as a JSON key/value pair
+class MatchEventJsonEncoder
+{
+    public:
+        MatchEventJsonEncoder (JsonWriter &_json) : json(_json) {}
+
+        template<typename T>
+        void operator() (const char* key, const T &value, MatchEventField /*role*/ = FIELD_REPORTED)
+        {
+            json.set(key, value);
+        }
+
+    private:
+        JsonWriter &json;
+};
+
+// Fill in the fixed-width timeline record of the event. Keys are implied by the record's layout so they are not
+// written, and fields without a place in the record are left out.
+class MatchEventBinaryEncoder
+{
+    public:
+        MatchEventBinaryEncoder (MatchTimelineRecord &_record) : record(_record) {}
+
+        void operator() (const char* /*key*/, const std::string &value, MatchEventField role = FIELD_REPORTED)
+        {
+            switch (role)
+            {
+                // Leave room for the terminator; BZIDs are far shorter than the field anyway
+                case FIELD_BZID:
+                    strncpy(record.bzID, value.c_str(), sizeof(record.bzID) - 1);
+                    break;
+
+                case FIELD_OTHER_BZID:
+                    strncpy(record.otherBZID, value.c_str(), sizeof(record.otherBZID) - 1);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        void operator() (const char* /*key*/, int value, MatchEventField role = FIELD_REPORTED)
+        {
+            switch (role)
+            {
+                case FIELD_TEAM:
+                    record.team = MatchTimeline::toTeam(value);
+                    break;
+
+                case FIELD_OTHER_TEAM:
+                    record.otherTeam = MatchTimeline::toTeam(value);
+                    break;
+
+                case FIELD_VALUE_ONE:
+                    record.values[0] = value;
+                    break;
+
+                case FIELD_VALUE_TWO:
+                    record.values[1] = value;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        void operator() (const char* /*key*/, bool /*value*/, MatchEventField /*role*/ = FIELD_REPORTED) {}
+
+    private:
+        MatchTimelineRecord &record;
+};
+
+// Append the fields shown by /stats as human readable text, i.e. "key: value, key: value"
+class MatchEventTextEncoder
+{
+    public:
+        MatchEventTextEncoder (std::string &_out) : out(_out), first(true) {}
+
+        void operator() (const char* key, const std::string &value, MatchEventField role = FIELD_REPORTED)
+        {
+            if (isShown(role))
+            {
+                label(key);
+                out += value;
+            }
+        }
+
+        void operator() (const char* key, int value, MatchEventField role = FIELD_REPORTED)
+        {
+            if (role == FIELD_TEAM || role == FIELD_OTHER_TEAM)
+            {
+                label(key);
+                out += formatTeam((bz_eTeamType)value);
+            }
+            else if (isShown(role))
+            {
+                label(key);
+                out += std::to_string(value);
+            }
+        }
+
+        void operator() (const char* key, bool value, MatchEventField role = FIELD_REPORTED)
+        {
+            if (isShown(role))
+            {
+                label(key);
+                out += (value) ? "yes" : "no";
+            }
+        }
+
+    private:
+        std::string &out;
+
+        bool        first;
+
+        // Players are shown by their callsigns; BZIDs mean nothing to them
+        static bool isShown (MatchEventField role)
+        {
+            return (role != FIELD_REPORTED && role != FIELD_BZID && role != FIELD_OTHER_BZID);
+        }
+
+        void label (const char* key)
+        {
+            if (!first)
+            {
+                out += ", ";
+            }
+
+            first = false;
+
+            out += key;
+            out += ": ";
+        }
+};
 
 template<class Derived>
 class MatchEvent
@@ -36,35 +196,68 @@ class MatchEvent
             PLAYER_KILL,
             PLAYER_JOIN,
             PLAYER_PART,
+            MATCH_PAUSE,
+            MATCH_RESUME,
             LAST_LOS_EVENT_TYPE
         };
 
         const char* toString (void)
         {
-            return json_object_to_json_string(jsonObj);
+            return json.c_str();
         }
 
-        json_object *getJsonObject (void)
+        // Serialize the event into JSON, which is available afterwards through toString()
+        Derived& save (void)
         {
-            return jsonData;
+            json.reset();
+            json.beginObject()
+                    .set("type", losEventTypeToString(eventType))
+                    .key("data").beginObject();
+
+            MatchEventJsonEncoder encoder(json);
+            This()->schema(encoder);
+
+            json.endObject()
+                .endObject();
+
+            return *This();
+        }
+
+        // Fill in the timeline record of the event; false if the timeline doesn't track this kind of event
+        bool toBinary (MatchTimelineRecord &record)
+        {
+            memset(&record, 0, sizeof(record));
+
+            record.type      = losEventTypeToTimeline(eventType);
+            record.team      = MATCH_TIMELINE_NO_TEAM;
+            record.otherTeam = MATCH_TIMELINE_NO_TEAM;
+
+            MatchEventBinaryEncoder encoder(record);
+            This()->schema(encoder);
+
+            return (record.type != LAST_TIMELINE_EVENT_TYPE);
         }
 
-        virtual Derived& save (void) = 0;
+        // Get a human readable representation of the event for in-game output
+        std::string toText (void)
+        {
+            std::string out = std::string(losEventTypeToString(eventType)) + " (";
+
+            MatchEventTextEncoder encoder(out);
+            This()->schema(encoder);
+
+            return out + ")";
+        }
 
     protected:
         LosEventType eventType;
 
-        json_object  *jsonObj = json_object_new_object();
-        json_object  *jsonData = json_object_new_object();
+        JsonWriter   json;
 
         Derived& setEventType (LosEventType _eventType)
         {
             eventType = _eventType;
 
-            json_object *jEventType = json_object_new_string(losEventTypeToString(_eventType));
-
-            json_object_object_add(jsonObj, "type", jEventType);
-
             return *This();
         }
 
@@ -87,10 +280,44 @@ class MatchEvent
                 case PLAYER_PART:
                     return "part";
 
+                case MATCH_PAUSE:
+                    return "pause";
+
+                case MATCH_RESUME:
+                    return "resume";
+
                 default:
                     return "noEvent";
             }
         }
+
+        uint8_t losEventTypeToTimeline (LosEventType _eventType)
+        {
+            switch (_eventType)
+            {
+                case CAPTURE:
+                    return TIMELINE_CAPTURE;
+
+                case PLAYER_KILL:
+                    return TIMELINE_KILL;
+
+                case PLAYER_JOIN:
+                    return TIMELINE_JOIN;
+
+                case PLAYER_PART:
+                    return TIMELINE_PART;
+
+                case MATCH_PAUSE:
+                    return TIMELINE_PAUSE;
+
+                case MATCH_RESUME:
+                    return TIMELINE_RESUME;
+
+                // A substitution is already in the timeline as a part and a join
+                default:
+                    return LAST_TIMELINE_EVENT_TYPE;
+            }
+        }
 };
 
 #endif
\ No newline at end of file
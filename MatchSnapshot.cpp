@@ -0,0 +1,61 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+
+#include "MatchSnapshot.h"
+
+MatchSnapshotSlot::MatchSnapshotSlot () :
+    sequence(0)
+{
+    memset(&data, 0, sizeof(data));
+
+    data.version = MATCH_SNAPSHOT_VERSION;
+    data.state   = MATCH_STATE_NONE;
+}
+
+void MatchSnapshotSlot::publish (const MatchSnapshot &snapshot)
+{
+    unsigned int current = sequence.load(std::memory_order_relaxed);
+
+    // An odd sequence number tells readers that a write is in progress
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    data          = snapshot;
+    data.version  = MATCH_SNAPSHOT_VERSION;
+    data.sequence = (current + 2) / 2;
+
+    sequence.store(current + 2, std::memory_order_release);
+}
+
+void MatchSnapshotSlot::read (MatchSnapshot &snapshot) const
+{
+    unsigned int before, after;
+
+    do
+    {
+        before = sequence.load(std::memory_order_acquire);
+
+        snapshot = data;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    }
+    while ((before & 1) || before != after);
+}
\ No newline at end of file
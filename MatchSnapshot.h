@@ -0,0 +1,81 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MATCH_SNAPSHOT_H__
+#define __MATCH_SNAPSHOT_H__
+
+#include <atomic>
+
+// The layout version of the MatchSnapshot struct. This number is bumped whenever a field is added or changed so
+// plug-ins compiled against an older copy of this header can't misread the data.
+const int MATCH_SNAPSHOT_VERSION = 1;
+
+enum MatchSnapshotState
+{
+    MATCH_STATE_NONE,       // There is no match going on
+    MATCH_STATE_COUNTDOWN,  // A match countdown has been started
+    MATCH_STATE_RUNNING,    // A match is being played
+    MATCH_STATE_PAUSED      // A match is paused
+};
+
+// A plain copy of the current match state that other plug-ins can fetch every tick through the 'GetMatchSnapshot'
+// generic callback. Set 'version' to MATCH_SNAPSHOT_VERSION before making the call; the callback returns 1 when the
+// struct was filled and 0 if the versions don't match.
+//
+//     MatchSnapshot snapshot;
+//     snapshot.version = MATCH_SNAPSHOT_VERSION;
+//     bz_callPluginGenericCallback(bz_getclipFieldString("LeagueOverseer"), "GetMatchSnapshot", &snapshot);
+//
+// The snapshot is only rewritten when the state of a match changes, so while a match is running the time remaining
+// right now is 'timeRemaining - (bz_getCurrentTime() - updatedAt) * 1000'.
+struct MatchSnapshot
+{
+    int          version;        // The layout version the caller was compiled against
+
+    unsigned int sequence;       // Incremented each time the snapshot is updated
+
+    int          state;          // A MatchSnapshotState value
+    bool         official;       // Whether or not the match is an official match
+
+    int          teamOneColor,   // The bz_eTeamType values of the two teams playing on this map
+                 teamTwoColor,
+                 teamOneScore,   // The scores for an official match; fun match scores are not tracked
+                 teamTwoScore,
+                 rosterSize,     // The number of players recorded at the roll call of an official match
+                 timeRemaining;  // The time remaining in the match in milliseconds as of 'updatedAt'
+
+    double       updatedAt;      // The server time (bz_getCurrentTime()) when the snapshot was taken
+};
+
+// A single writer, many reader slot guarded by a sequence lock. Readers never block the writer and simply retry if
+// they raced with an update.
+class MatchSnapshotSlot
+{
+    public:
+        MatchSnapshotSlot ();
+
+        void publish (const MatchSnapshot &snapshot);
+        void read    (MatchSnapshot &snapshot) const;
+
+    private:
+        std::atomic<unsigned int> sequence;
+
+        MatchSnapshot             data;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "LeagueOverseer-Helpers.h"
+#include "MatchSummary.h"
+
+MatchSummary::MatchSummary () :
+    teamOneScore(0),
+    teamTwoScore(0),
+    pauseCount(0),
+    pausedSince(-1),
+    pausedSeconds(0)
+{}
+
+void MatchSummary::recordCapture (std::string matchTime, std::string bzID, std::string callsign, int _teamOneScore, int _teamTwoScore, CaptureMatchEvent &event)
+{
+    teamOneScore = _teamOneScore;
+    teamTwoScore = _teamTwoScore;
+
+    PlayerCaptures &player = capturesByPlayer[bzID];
+    player.callsign = callsign;
+    player.captures++;
+
+    timeline.push_back("  [" + matchTime + "] " + event.toText());
+}
+
+void MatchSummary::recordPause (std::string matchTime, double eventTime, PauseMatchEvent &event)
+{
+    pauseCount++;
+    pausedSince = eventTime;
+
+    timeline.push_back("  [" + matchTime + "] " + event.toText());
+}
+
+void MatchSummary::recordResume (std::string matchTime, double eventTime, PauseMatchEvent &event)
+{
+    if (pausedSince >= 0)
+    {
+        pausedSeconds += eventTime - pausedSince;
+        pausedSince = -1;
+    }
+
+    timeline.push_back("  [" + matchTime + "] " + event.toText());
+}
+
+int MatchSummary::getPageCount (void)
+{
+    return std::max(1, (int)((timeline.size() + LINES_PER_PAGE - 1) / LINES_PER_PAGE));
+}
+
+void MatchSummary::renderPage (int page, bz_eTeamType teamOne, bz_eTeamType teamTwo, std::vector<std::string> &lines)
+{
+    page = std::min(std::max(page, 1), getPageCount());
+
+    char line[256];
+
+    snprintf(line, sizeof(line), "Match Data (page %d of %d)", page, getPageCount());
+    lines.push_back(line);
+    lines.push_back("----------");
+
+    snprintf(line, sizeof(line), "  Score    : %s %d - %d %s", formatTeam(teamOne).c_str(), teamOneScore, teamTwoScore, formatTeam(teamTwo).c_str());
+    lines.push_back(line);
+
+    int totalPaused = pausedSeconds;
+    snprintf(line, sizeof(line), "  Pauses   : %d (%d:%02d total)", pauseCount, totalPaused / 60, totalPaused % 60);
+    lines.push_back(line);
+
+    if (!capturesByPlayer.empty())
+    {
+        std::string captures = "  Captures :";
+
+        for (std::map<std::string, PlayerCaptures>::const_iterator it = capturesByPlayer.begin(); it != capturesByPlayer.end(); ++it)
+        {
+            captures += " " + it->second.callsign + " (" + std::to_string(it->second.captures) + ")";
+        }
+
+        lines.push_back(captures);
+    }
+
+    unsigned int first = (page - 1) * LINES_PER_PAGE,
+                 last  = std::min((unsigned int)timeline.size(), first + LINES_PER_PAGE);
+
+    for (unsigned int i = first; i < last; i++)
+    {
+        lines.push_back(timeline.at(i));
+    }
+
+    if (page < getPageCount())
+    {
+        snprintf(line, sizeof(line), "  Use '/stats %d' to see more.", page + 1);
+        lines.push_back(line);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MATCH_SUMMARY_H__
+#define __MATCH_SUMMARY_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bzfsAPI.h"
+
+#include "MatchEvent-Capture.h"
+#include "MatchEvent-Pause.h"
+
+// A summary of an official match that is updated as events happen so the /stats command only has to format the
+// page that was requested instead of walking every event of the match. The lines of the score timeline are the text
+// form of each match event, so they show whatever its schema marks as shown.
+class MatchSummary
+{
+    public:
+        MatchSummary ();
+
+        void recordCapture (std::string matchTime, std::string bzID, std::string callsign, int teamOneScore, int teamTwoScore, CaptureMatchEvent &event);
+        void recordPause   (std::string matchTime, double eventTime, PauseMatchEvent &event);
+        void recordResume  (std::string matchTime, double eventTime, PauseMatchEvent &event);
+
+        int  getPageCount  (void);
+        void renderPage    (int page, bz_eTeamType teamOne, bz_eTeamType teamTwo, std::vector<std::string> &lines);
+
+        static const int LINES_PER_PAGE = 8;
+
+    private:
+        struct PlayerCaptures
+        {
+            std::string callsign;
+
+            int         captures;
+
+            PlayerCaptures () : captures(0) {}
+        };
+
+        // Every line of the score timeline, already formatted
+        std::vector<std::string> timeline;
+
+        // The number of captures each player has made, stored as <BZID, captures>
+        std::map<std::string, PlayerCaptures> capturesByPlayer;
+
+        int    teamOneScore,
+               teamTwoScore,
+               pauseCount;
+
+        double pausedSince,
+               pausedSeconds;
+};
+
+#endif
\ No newline at end of file
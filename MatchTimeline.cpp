@@ -0,0 +1,150 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+
+#include "MatchTimeline.h"
+
+MatchTimeline::MatchTimeline () :
+    file(NULL),
+    buffer(64 * sizeof(MatchTimelineRecord)),
+    matchStarted(0)
+{
+    memset(&header, 0, sizeof(header));
+}
+
+MatchTimeline::~MatchTimeline ()
+{
+    close();
+}
+
+bool MatchTimeline::open (std::string path, double _matchStarted, time_t startedAt, int teamOne, int teamTwo)
+{
+    close();
+
+    file = fopen(path.c_str(), "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    setvbuf(file, &buffer[0], _IOFBF, buffer.size());
+
+    matchStarted = _matchStarted;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MATCH_TIMELINE_MAGIC, sizeof(header.magic));
+
+    header.version    = MATCH_TIMELINE_VERSION;
+    header.recordSize = sizeof(MatchTimelineRecord);
+    header.startedAt  = (int64_t)startedAt;
+    header.teamOne    = toTeam(teamOne);
+    header.teamTwo    = toTeam(teamTwo);
+    header.byteOrder  = MATCH_TIMELINE_BYTE_ORDER;
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        close();
+        return false;
+    }
+
+    record(TIMELINE_MATCH_START, matchStarted, "", "", teamOne, teamTwo);
+
+    return true;
+}
+
+void MatchTimeline::record (MatchTimelineEventType type, double eventTime, std::string bzID, std::string otherBZID, int team, int otherTeam, int valueOne, int valueTwo, uint8_t flags)
+{
+    if (!file)
+    {
+        return;
+    }
+
+    MatchTimelineRecord entry;
+    memset(&entry, 0, sizeof(entry));
+
+    entry.type      = (uint8_t)type;
+    entry.team      = toTeam(team);
+    entry.otherTeam = toTeam(otherTeam);
+    entry.flags     = flags;
+    entry.values[0] = valueOne;
+    entry.values[1] = valueTwo;
+
+    // Leave room for the terminator; BZIDs are far shorter than the field anyway
+    strncpy(entry.bzID, bzID.c_str(), sizeof(entry.bzID) - 1);
+    strncpy(entry.otherBZID, otherBZID.c_str(), sizeof(entry.otherBZID) - 1);
+
+    append(eventTime, entry);
+}
+
+// Write a record that has been filled in elsewhere, e.g. by a match event's toBinary(), stamped with its offset
+void MatchTimeline::append (double eventTime, MatchTimelineRecord &entry)
+{
+    if (!file)
+    {
+        return;
+    }
+
+    entry.offset = (eventTime > matchStarted) ? (uint32_t)((eventTime - matchStarted) * 1000) : 0;
+
+    fwrite(&entry, sizeof(entry), 1, file);
+}
+
+void MatchTimeline::flush (void)
+{
+    if (file)
+    {
+        fflush(file);
+    }
+}
+
+void MatchTimeline::close (void)
+{
+    if (file)
+    {
+        // Write the header again now that the team names are in it; the records are already in place after it
+        if (fseek(file, 0, SEEK_SET) == 0)
+        {
+            fwrite(&header, sizeof(header), 1, file);
+        }
+
+        fclose(file);
+        file = NULL;
+    }
+}
+
+// Remember the league names of the teams playing; they're written out when the timeline is closed
+void MatchTimeline::setTeamNames (std::string teamOneName, std::string teamTwoName)
+{
+    memset(header.teamOneName, 0, sizeof(header.teamOneName));
+    memset(header.teamTwoName, 0, sizeof(header.teamTwoName));
+
+    strncpy(header.teamOneName, teamOneName.c_str(), sizeof(header.teamOneName) - 1);
+    strncpy(header.teamTwoName, teamTwoName.c_str(), sizeof(header.teamTwoName) - 1);
+}
+
+bool MatchTimeline::isOpen (void)
+{
+    return (file != NULL);
+}
+
+uint8_t MatchTimeline::toTeam (int team)
+{
+    return (team < 0 || team >= MATCH_TIMELINE_NO_TEAM) ? MATCH_TIMELINE_NO_TEAM : (uint8_t)team;
+}
\ No newline at end of file
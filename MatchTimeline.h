@@ -0,0 +1,136 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MATCH_TIMELINE_H__
+#define __MATCH_TIMELINE_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// A binary timeline of everything that happened during an official match. The file is a MatchTimelineHeader followed
+// by fixed-width MatchTimelineRecords, written as they are laid out in memory in the host's byte order, so offline tools
+// can mmap() the file and index straight into the records:
+//
+//     count   = (fileSize - sizeof(MatchTimelineHeader)) / header->recordSize
+//     records = (const MatchTimelineRecord*)(base + sizeof(MatchTimelineHeader))
+//
+// A tool must check that the header's byteOrder reads back as MATCH_TIMELINE_BYTE_ORDER before trusting any other
+// number in the file; a timeline copied over from a host with the other byte order won't. This header doesn't depend
+// on BZFS so those tools can include it. Teams are stored as their bz_eTeamType value with
+// eNoTeam stored as MATCH_TIMELINE_NO_TEAM. The league names of the two teams aren't known until the roll call, so the
+// header is written again with them when the timeline is closed; they're left empty if the roll call never succeeded.
+
+#define MATCH_TIMELINE_MAGIC   "LOTL"
+#define MATCH_TIMELINE_VERSION 1
+#define MATCH_TIMELINE_NO_TEAM 0xFF
+
+#define MATCH_TIMELINE_BYTE_ORDER 0x0102
+
+#define MATCH_TIMELINE_TEAM_NAME_SIZE 64
+
+enum MatchTimelineEventType
+{
+    TIMELINE_MATCH_START = 0,   // team, otherTeam: the two teams playing
+    TIMELINE_MATCH_END,         // team, otherTeam: the two teams playing; values: their scores; flags: canceled
+    TIMELINE_CAPTURE,           // bzID: the capper; team: the capping team; otherTeam: the capped team; values: the scores after the capture
+    TIMELINE_JOIN,              // bzID: the player; team: the team they joined
+    TIMELINE_PART,              // bzID: the player; team: the team they left
+    TIMELINE_PAUSE,             // bzID: who paused the match, if it was a player
+    TIMELINE_RESUME,            // bzID: who resumed the match, if it was a player
+    TIMELINE_KILL,              // bzID: the victim; otherBZID: the killer; team, otherTeam: their teams; values[0]: the shot ID
+    LAST_TIMELINE_EVENT_TYPE
+};
+
+#define MATCH_TIMELINE_CANCELED 0x01
+
+struct MatchTimelineHeader
+{
+    char     magic[4];      // MATCH_TIMELINE_MAGIC
+    uint16_t version;       // MATCH_TIMELINE_VERSION
+    uint16_t recordSize;    // sizeof(MatchTimelineRecord); readers should step by this value
+    int64_t  startedAt;     // The UTC Unix timestamp of when the match started
+    uint8_t  teamOne,
+             teamTwo;
+    uint16_t byteOrder;     // MATCH_TIMELINE_BYTE_ORDER as the writing host stores it
+    uint8_t  reserved[12];
+    char     teamOneName[MATCH_TIMELINE_TEAM_NAME_SIZE],   // NUL terminated league team names from the roll call
+             teamTwoName[MATCH_TIMELINE_TEAM_NAME_SIZE];
+};
+
+struct MatchTimelineRecord
+{
+    uint32_t offset;        // Milliseconds since the match started
+    uint8_t  type;          // A MatchTimelineEventType
+    uint8_t  team,
+             otherTeam,
+             flags;
+    int32_t  values[2];
+    char     bzID[24],      // NUL terminated; empty if there was no player
+             otherBZID[24];
+};
+
+static_assert(sizeof(MatchTimelineHeader) == 160, "The timeline header must stay 160 bytes");
+static_assert(sizeof(MatchTimelineRecord) == 64, "Timeline records must stay 64 bytes");
+
+// Appends the records of an official match to its timeline file. Records go through a stdio buffer so a match only
+// costs a write every few dozen events; the buffer is flushed when the match is paused and when the file is closed.
+class MatchTimeline
+{
+    public:
+        MatchTimeline ();
+        ~MatchTimeline ();
+
+        bool open   (std::string path, double matchStarted, time_t startedAt, int teamOne, int teamTwo);
+        void record (MatchTimelineEventType type, double eventTime, std::string bzID = "", std::string otherBZID = "",
+                     int team = -1, int otherTeam = -1, int valueOne = 0, int valueTwo = 0, uint8_t flags = 0);
+        void append (double eventTime, MatchTimelineRecord &entry);
+
+        // Append the record a match event builds from its schema; the event types aren't included here so offline
+        // tools can keep using this header without BZFS
+        template<class Event>
+        void recordEvent (double eventTime, Event &event)
+        {
+            MatchTimelineRecord entry;
+
+            if (file && event.toBinary(entry))
+            {
+                append(eventTime, entry);
+            }
+        }
+        void flush  (void);
+        void close  (void);
+
+        void setTeamNames (std::string teamOneName, std::string teamTwoName);
+
+        bool isOpen (void);
+
+        static uint8_t toTeam (int team);
+
+    private:
+        FILE*               file;
+        std::vector<char>   buffer;
+
+        MatchTimelineHeader header;
+
+        double              matchStarted;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <sstream>
+
+#include "LeagueOverseer-Helpers.h"
+#include "Metrics.h"
+
+const double Metrics::latencyBuckets[Metrics::LATENCY_BUCKET_COUNT] = { 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30 };
+
+Metrics::Metrics () :
+    urlJobLatencyMicroseconds(0),
+    interval(15),
+    stopping(false)
+{
+    for (Counter &counter : events)        { counter = 0; }
+    for (Counter &counter : counters)      { counter = 0; }
+    for (Counter &counter : urlJobs)       { counter = 0; }
+    for (Counter &counter : urlJobLatency) { counter = 0; }
+
+    for (auto &official : matches)
+    {
+        official[0] = official[1] = 0;
+    }
+
+    for (std::atomic<long long> &gauge : gauges)
+    {
+        gauge = 0;
+    }
+}
+
+Metrics::~Metrics ()
+{
+    stop();
+}
+
+// Start writing the metrics to a file every few seconds. The file is written once before this returns so a path we
+// can't write to is reported instead of being retried in the background forever.
+bool Metrics::start (std::string _path, int _interval)
+{
+    stop();
+
+    path     = _path;
+    interval = _interval;
+    stopping = false;
+
+    if (!write())
+    {
+        return false;
+    }
+
+    worker = std::thread(&Metrics::run, this);
+
+    return true;
+}
+
+void Metrics::stop (void)
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+
+    // Leave the final values behind rather than whatever was last written
+    write();
+}
+
+bool Metrics::running (void)
+{
+    return worker.joinable();
+}
+
+void Metrics::eventHandled (bz_eEventType eventType)
+{
+    if (eventType >= 0 && eventType < bz_eLastEvent)
+    {
+        events[eventType].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::increment (MetricCounter counter)
+{
+    counters[counter].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::setGauge (MetricGauge gauge, long long value)
+{
+    gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void Metrics::matchEnded (bool official, bool canceled)
+{
+    matches[official][canceled].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::urlJobFinished (UrlJobOutcome outcome, std::chrono::steady_clock::duration _elapsed)
+{
+    urlJobs[outcome].fetch_add(1, std::memory_order_relaxed);
+
+    std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(_elapsed);
+
+    double seconds = elapsed.count() / 1000000.0;
+    int    bucket  = 0;
+
+    while (bucket < LATENCY_BUCKET_COUNT && seconds > latencyBuckets[bucket])
+    {
+        bucket++;
+    }
+
+    urlJobLatency[bucket].fetch_add(1, std::memory_order_relaxed);
+    urlJobLatencyMicroseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+}
+
+void Metrics::run (void)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopping)
+    {
+        wake.wait_for(lock, std::chrono::seconds(interval), [this]() { return stopping; });
+
+        if (stopping)
+        {
+            break;
+        }
+
+        lock.unlock();
+        write();
+        lock.lock();
+    }
+}
+
+// Write the metrics next to the file and rename it into place so node_exporter never reads a partial file
+bool Metrics::write (void)
+{
+    std::string contents  = render();
+    std::string temporary = path + ".tmp";
+
+    FILE *file = fopen(temporary.c_str(), "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = (fwrite(contents.data(), 1, contents.size(), file) == contents.size());
+
+    if (fclose(file) != 0 || !written || rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+std::string Metrics::render (void)
+{
+    std::ostringstream out;
+
+    out << "# HELP leagueoverseer_events_total Events handled by the plug-in.\n"
+        << "# TYPE leagueoverseer_events_total counter\n";
+
+    for (int eventType = 0; eventType < bz_eLastEvent; eventType++)
+    {
+        if (getEventName((bz_eEventType)eventType))
+        {
+            out << "leagueoverseer_events_total{event=\"" << getEventName((bz_eEventType)eventType) << "\"} " << events[eventType].load(std::memory_order_relaxed) << "\n";
+        }
+    }
+
+    static const char* outcomes[LAST_URL_JOB_OUTCOME] = { "done", "timeout", "error" };
+
+    out << "# HELP leagueoverseer_url_jobs_total Requests to the league site by how they finished.\n"
+        << "# TYPE leagueoverseer_url_jobs_total counter\n";
+
+    for (int outcome = 0; outcome < LAST_URL_JOB_OUTCOME; outcome++)
+    {
+        out << "leagueoverseer_url_jobs_total{outcome=\"" << outcomes[outcome] << "\"} " << urlJobs[outcome].load(std::memory_order_relaxed) << "\n";
+    }
+
+    out << "# HELP leagueoverseer_url_job_duration_seconds The time it took for requests to the league site to finish.\n"
+        << "# TYPE leagueoverseer_url_job_duration_seconds histogram\n";
+
+    unsigned long long cumulative = 0;
+
+    for (int bucket = 0; bucket <= LATENCY_BUCKET_COUNT; bucket++)
+    {
+        cumulative += urlJobLatency[bucket].load(std::memory_order_relaxed);
+
+        out << "leagueoverseer_url_job_duration_seconds_bucket{le=\"";
+
+        if (bucket < LATENCY_BUCKET_COUNT)
+        {
+            out << latencyBuckets[bucket];
+        }
+        else
+        {
+            out << "+Inf";
+        }
+
+        out << "\"} " << cumulative << "\n";
+    }
+
+    out << "leagueoverseer_url_job_duration_seconds_sum " << urlJobLatencyMicroseconds.load(std::memory_order_relaxed) / 1000000.0 << "\n"
+        << "leagueoverseer_url_job_duration_seconds_count " << cumulative << "\n";
+
+    out << "# HELP leagueoverseer_roll_call_retries_total Roll calls that had to be tried again later.\n"
+        << "# TYPE leagueoverseer_roll_call_retries_total counter\n"
+        << "leagueoverseer_roll_call_retries_total " << counters[METRIC_ROLL_CALL_RETRIES].load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP leagueoverseer_matches_total Matches that have ended by type and result.\n"
+        << "# TYPE leagueoverseer_matches_total counter\n";
+
+    for (int official = 0; official < 2; official++)
+    {
+        for (int canceled = 0; canceled < 2; canceled++)
+        {
+            out << "leagueoverseer_matches_total{type=\"" << (official ? "official" : "fun") << "\",result=\"" << (canceled ? "canceled" : "completed") << "\"} "
+                << matches[official][canceled].load(std::memory_order_relaxed) << "\n";
+        }
+    }
+
+    out << "# HELP leagueoverseer_chat_rejections_total Chat messages that were not delivered by the reason they were rejected.\n"
+        << "# TYPE leagueoverseer_chat_rejections_total counter\n"
+        << "leagueoverseer_chat_rejections_total{reason=\"muted\"} " << counters[METRIC_CHAT_REJECTED_MUTED].load(std::memory_order_relaxed) << "\n"
+        << "leagueoverseer_chat_rejections_total{reason=\"policy\"} " << counters[METRIC_CHAT_REJECTED_POLICY].load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP leagueoverseer_team_mottos The number of team names held for players.\n"
+        << "# TYPE leagueoverseer_team_mottos gauge\n"
+        << "leagueoverseer_team_mottos " << gauges[METRIC_GAUGE_TEAM_MOTTOS].load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP leagueoverseer_muted_players The number of players on the league's mute list.\n"
+        << "# TYPE leagueoverseer_muted_players gauge\n"
+        << "leagueoverseer_muted_players " << gauges[METRIC_GAUGE_MUTED_PLAYERS].load(std::memory_order_relaxed) << "\n";
+
+    return out.str();
+}
\ No newline at end of file
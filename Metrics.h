@@ -0,0 +1,103 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "bzfsAPI.h"
+
+enum MetricCounter
+{
+    METRIC_CHAT_REJECTED_MUTED,     // Messages from players muted by the league
+    METRIC_CHAT_REJECTED_POLICY,    // Messages from non-league members that the chat policy didn't allow
+    METRIC_ROLL_CALL_RETRIES,       // Roll calls that had to be tried again later
+    LAST_METRIC_COUNTER
+};
+
+enum MetricGauge
+{
+    METRIC_GAUGE_TEAM_MOTTOS,       // The number of team names we're holding on to for players
+    METRIC_GAUGE_MUTED_PLAYERS,     // The number of players on the league's mute list
+    LAST_METRIC_GAUGE
+};
+
+enum UrlJobOutcome
+{
+    URL_JOB_DONE,
+    URL_JOB_TIMEOUT,
+    URL_JOB_ERROR,
+    LAST_URL_JOB_OUTCOME
+};
+
+// Counters and gauges that are written in the Prometheus text format to a file for node_exporter's textfile collector
+// to pick up. Updating a metric is a single relaxed atomic operation so the server's thread never waits on anything;
+// a background thread reads them every few seconds and replaces the file so a scrape never sees half of it.
+//
+// Each URL job is timed by the UrlQuery that sent it, since BZFS and the relay daemon don't answer them in any set order.
+class Metrics
+{
+    public:
+        Metrics ();
+        ~Metrics ();
+
+        bool start   (std::string path, int interval);
+        void stop    (void);
+        bool running (void);
+
+        void eventHandled    (bz_eEventType eventType);
+        void increment       (MetricCounter counter);
+        void setGauge        (MetricGauge gauge, long long value);
+        void matchEnded      (bool official, bool canceled);
+        void urlJobFinished  (UrlJobOutcome outcome, std::chrono::steady_clock::duration elapsed);
+
+    private:
+        typedef std::atomic<unsigned long long> Counter;
+
+        static const int    LATENCY_BUCKET_COUNT = 9;
+        static const double latencyBuckets[LATENCY_BUCKET_COUNT];
+
+        Counter                 events[bz_eLastEvent],
+                                counters[LAST_METRIC_COUNTER],
+                                matches[2][2],                          // [official][canceled]
+                                urlJobs[LAST_URL_JOB_OUTCOME],
+                                urlJobLatency[LATENCY_BUCKET_COUNT + 1], // The last bucket is +Inf
+                                urlJobLatencyMicroseconds;
+
+        std::atomic<long long>  gauges[LAST_METRIC_GAUGE];
+
+        std::string             path;
+        int                     interval;
+
+        std::thread             worker;
+        std::mutex              mutex;
+        std::condition_variable wake;
+        bool                    stopping;
+
+        void        run    (void);
+        bool        write  (void);
+        std::string render (void);
+};
+
+#endif
\ No newline at end of file
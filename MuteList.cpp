@@ -0,0 +1,117 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+
+#include "MuteList.h"
+
+MuteList::MuteList () :
+    filter(1, 0),
+    filterMask(63),
+    version(0)
+{}
+
+// Apply an update from the league site. A full update replaces the list; otherwise the changes since the version we
+// already have are merged into it.
+void MuteList::apply (int _version, bool full, const std::vector<std::string> &muted, const std::vector<std::string> &unmuted)
+{
+    if (full)
+    {
+        bzIDs.clear();
+    }
+
+    for (auto &bzID : muted)
+    {
+        uint32_t value = toBZID(bzID.c_str());
+
+        if (value != 0)
+        {
+            bzIDs.push_back(value);
+        }
+    }
+
+    std::sort(bzIDs.begin(), bzIDs.end());
+    bzIDs.erase(std::unique(bzIDs.begin(), bzIDs.end()), bzIDs.end());
+
+    for (auto &bzID : unmuted)
+    {
+        std::vector<uint32_t>::iterator position = std::lower_bound(bzIDs.begin(), bzIDs.end(), toBZID(bzID.c_str()));
+
+        if (position != bzIDs.end() && *position == toBZID(bzID.c_str()))
+        {
+            bzIDs.erase(position);
+        }
+    }
+
+    // Don't hold on to the room a large full list needed once it has shrunk
+    if (bzIDs.capacity() > bzIDs.size() * 2 + 64)
+    {
+        std::vector<uint32_t>(bzIDs).swap(bzIDs);
+    }
+
+    version = _version;
+
+    rebuildFilter();
+}
+
+int MuteList::getVersion (void) const
+{
+    return version;
+}
+
+size_t MuteList::size (void) const
+{
+    return bzIDs.size();
+}
+
+// BZIDs are numeric; anything else can't be muted by the league
+uint32_t MuteList::toBZID (const char* bzID)
+{
+    char* end;
+    unsigned long value = strtoul(bzID, &end, 10);
+
+    return (*bzID != '\0' && *end == '\0' && value <= UINT32_MAX) ? (uint32_t)value : 0;
+}
+
+// Size the filter at roughly 16 bits per BZID, which with four hashes lets through well under 1% of unmuted players
+void MuteList::rebuildFilter (void)
+{
+    uint32_t bits = 64;
+
+    while (bits < bzIDs.size() * 16 && bits < (1U << 31))
+    {
+        bits <<= 1;
+    }
+
+    filter.assign(bits / 64, 0);
+    filterMask = bits - 1;
+
+    for (auto bzID : bzIDs)
+    {
+        uint64_t hashed = hash(bzID);
+        uint32_t first  = (uint32_t)hashed,
+                 second = (uint32_t)(hashed >> 32) | 1;
+
+        for (int i = 0; i < HASH_COUNT; i++)
+        {
+            uint32_t bit = (first + i * second) & filterMask;
+
+            filter[bit >> 6] |= (1ULL << (bit & 63));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MUTE_LIST_H__
+#define __MUTE_LIST_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The league-wide list of muted players. The BZIDs are kept as a sorted array of integers behind a Bloom filter so
+// the chat handler can turn away almost every message from a player who isn't muted with a few bit tests, and only
+// searches the array when the filter says the player might be muted.
+class MuteList
+{
+    public:
+        MuteList ();
+
+        void apply (int version, bool full, const std::vector<std::string> &muted, const std::vector<std::string> &unmuted);
+
+        bool isMuted (uint32_t bzID) const
+        {
+            return bzID != 0 && mightContain(bzID) && std::binary_search(bzIDs.begin(), bzIDs.end(), bzID);
+        }
+
+        int    getVersion (void) const;
+        size_t size       (void) const;
+
+        static uint32_t toBZID (const char* bzID);
+
+    private:
+        static const int HASH_COUNT = 4;
+
+        std::vector<uint32_t> bzIDs;
+        std::vector<uint64_t> filter;
+
+        uint32_t              filterMask;   // The number of bits in the filter minus one; always a power of two minus one
+        int                   version;
+
+        void rebuildFilter (void);
+
+        static uint64_t hash (uint32_t bzID)
+        {
+            // splitmix64 finalizer; BZIDs are sequential so they need to be mixed before they're spread over the filter
+            uint64_t mixed = bzID + 0x9e3779b97f4a7c15ULL;
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+
+            return mixed ^ (mixed >> 31);
+        }
+
+        bool mightContain (uint32_t bzID) const
+        {
+            uint64_t hashed = hash(bzID);
+            uint32_t first  = (uint32_t)hashed,
+                     second = (uint32_t)(hashed >> 32) | 1;
+
+            for (int i = 0; i < HASH_COUNT; i++)
+            {
+                uint32_t bit = (first + i * second) & filterMask;
+
+                if (!(filter[bit >> 6] & (1ULL << (bit & 63))))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bzfsAPI.h"
+
+#include "PermissionManager.h"
+
+static const char* permissionName (uint32_t permission)
+{
+    switch (permission)
+    {
+        case MANAGED_PERM_POLL:
+            return "poll";
+
+        default:
+            return "";
+    }
+}
+
+PermissionManager::PermissionManager () :
+    desired(0)
+{
+    for (Slot &slot : slots)
+    {
+        slot.present = false;
+        slot.applied = 0;
+        slot.revoked = 0;
+    }
+}
+
+// Change the permissions the current match state revokes and bring every player out of line with it back in line
+void PermissionManager::setRevoked (uint32_t permissions)
+{
+    if (permissions == desired)
+    {
+        return;
+    }
+
+    desired = permissions;
+
+    for (int playerID = 0; playerID < 256; playerID++)
+    {
+        if (slots[playerID].present && slots[playerID].applied != desired)
+        {
+            sync(playerID);
+        }
+    }
+}
+
+uint32_t PermissionManager::getRevoked (void) const
+{
+    return desired;
+}
+
+// Players who join in the middle of a match are held to the same rules as everyone who was already playing
+void PermissionManager::playerJoined (int playerID)
+{
+    if (playerID < 0 || playerID >= 256)
+    {
+        return;
+    }
+
+    Slot &slot = slots[playerID];
+
+    slot.present = true;
+    slot.applied = 0;
+    slot.revoked = 0;
+
+    sync(playerID);
+}
+
+// The server forgets a player's permissions when they leave so there's nothing to give back
+void PermissionManager::playerLeft (int playerID)
+{
+    if (playerID < 0 || playerID >= 256)
+    {
+        return;
+    }
+
+    Slot &slot = slots[playerID];
+
+    slot.present = false;
+    slot.applied = 0;
+    slot.revoked = 0;
+}
+
+void PermissionManager::sync (int playerID)
+{
+    Slot &slot = slots[playerID];
+
+    uint32_t toRevoke  = desired & ~slot.applied;
+    uint32_t toRestore = slot.applied & ~desired;
+
+    for (uint32_t permission = 1; permission < LAST_MANAGED_PERM; permission <<= 1)
+    {
+        if (toRevoke & permission)
+        {
+            // A player without the permission has nothing to lose, and nothing to get back later
+            if (bz_hasPerm(playerID, permissionName(permission)))
+            {
+                bz_revokePerm(playerID, permissionName(permission));
+                slot.revoked |= permission;
+            }
+        }
+        else if ((toRestore & permission) && (slot.revoked & permission))
+        {
+            bz_grantPerm(playerID, permissionName(permission));
+            slot.revoked &= ~permission;
+        }
+    }
+
+    slot.applied = desired;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __PERMISSION_MANAGER_H__
+#define __PERMISSION_MANAGER_H__
+
+#include <stdint.h>
+
+// The server permissions we take away from players while a match is being played. Each one is a single bit so the
+// permissions a match state revokes and the permissions that have been revoked from a player are simple masks.
+enum ManagedPermission
+{
+    MANAGED_PERM_POLL = 1 << 0,     // Starting polls, e.g. a poll to kick a player in the middle of an official match
+    LAST_MANAGED_PERM = 1 << 1
+};
+
+// Keeps track of which managed permissions the current match state revokes and which ones we've actually revoked
+// from each player slot so changing the state only touches the players whose permissions don't match it. We only
+// give back what we took, so a player whose group never had a permission doesn't gain it once a match ends.
+class PermissionManager
+{
+    public:
+        PermissionManager ();
+
+        void     setRevoked   (uint32_t permissions);
+        uint32_t getRevoked   (void) const;
+        void     playerJoined (int playerID);
+        void     playerLeft   (int playerID);
+
+    private:
+        struct Slot
+        {
+            bool     present;
+            uint32_t applied,   // The state this slot was last brought in line with
+                     revoked;   // The permissions we've taken away from the player in this slot
+        };
+
+        void sync (int playerID);
+
+        uint32_t desired;
+        Slot     slots[256];
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RateLimiter.h"
+
+const RateLimiter::Limit RateLimiter::limits[LAST_RATE_LIMIT] = {
+    { 1.0, 5.0 },   // RATE_LIMIT_NOTICE
+    { 3.0, 5.0 }    // RATE_LIMIT_COMMAND
+};
+
+RateLimiter::RateLimiter ()
+{
+    for (int playerID = 0; playerID < 256; playerID++)
+    {
+        reset(playerID);
+    }
+}
+
+// Take a token for an action, returning false if the player has to wait before doing it again
+bool RateLimiter::take (int playerID, RateLimitType type, double now)
+{
+    if (playerID < 0 || playerID >= 256)
+    {
+        return true;
+    }
+
+    Bucket &bucket = buckets[playerID][type];
+    const Limit &limit = limits[type];
+
+    // A bucket that has never been used or has been reset starts out full
+    if (bucket.lastRefill < 0 || now < bucket.lastRefill)
+    {
+        bucket.tokens = limit.capacity;
+    }
+    else
+    {
+        bucket.tokens += (now - bucket.lastRefill) / limit.interval;
+
+        if (bucket.tokens > limit.capacity)
+        {
+            bucket.tokens = limit.capacity;
+        }
+    }
+
+    bucket.lastRefill = now;
+
+    if (bucket.tokens < 1.0)
+    {
+        bucket.suppressed++;
+        return false;
+    }
+
+    bucket.tokens -= 1.0;
+    bucket.suppressed = 0;
+
+    return true;
+}
+
+// The number of actions that have been refused in a row since the last one that was allowed
+int RateLimiter::suppressed (int playerID, RateLimitType type) const
+{
+    if (playerID < 0 || playerID >= 256)
+    {
+        return 0;
+    }
+
+    return buckets[playerID][type].suppressed;
+}
+
+// Start a slot over with full buckets; used when a player joins or leaves
+void RateLimiter::reset (int playerID)
+{
+    if (playerID < 0 || playerID >= 256)
+    {
+        return;
+    }
+
+    for (int type = 0; type < LAST_RATE_LIMIT; type++)
+    {
+        buckets[playerID][type].tokens     = limits[type].capacity;
+        buckets[playerID][type].lastRefill = -1;
+        buckets[playerID][type].suppressed = 0;
+    }
+}
\ No newline at end of file
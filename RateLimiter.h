@@ -0,0 +1,61 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __RATE_LIMITER_H__
+#define __RATE_LIMITER_H__
+
+enum RateLimitType
+{
+    RATE_LIMIT_NOTICE,      // Messages we send a player when we deny them something, e.g. spawning or talking
+    RATE_LIMIT_COMMAND,     // Slash commands that do a lot of work or send a lot of output
+    LAST_RATE_LIMIT
+};
+
+// A token bucket for each player slot and type of action, all kept in one array. Every action takes a token and
+// tokens slowly refill up to the size of the bucket, so a player can do a few things in a row but not keep doing
+// them. Anything that finds the bucket empty is counted instead so callers can coalesce what they would've sent.
+class RateLimiter
+{
+    public:
+        RateLimiter ();
+
+        bool take       (int playerID, RateLimitType type, double now);
+        int  suppressed (int playerID, RateLimitType type) const;
+        void reset      (int playerID);
+
+    private:
+        struct Bucket
+        {
+            double tokens,
+                   lastRefill;
+
+            int    suppressed;
+        };
+
+        struct Limit
+        {
+            double capacity,    // The number of actions that may be taken back to back
+                   interval;    // The number of seconds it takes for a single token to be refilled
+        };
+
+        static const Limit limits[LAST_RATE_LIMIT];
+
+        Bucket buckets[256][LAST_RATE_LIMIT];
+};
+
+#endif
\ No newline at end of file
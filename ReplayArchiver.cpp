@@ -0,0 +1,445 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include "ReplayArchiver.h"
+
+///
+/// SHA-256
+///
+
+struct Sha256State
+{
+    uint32_t      state[8];
+    uint64_t      length;
+    unsigned char block[64];
+    size_t        blockSize;
+};
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotateRight (uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+static void sha256Transform (Sha256State &sha, const unsigned char* data)
+{
+    uint32_t w[64];
+
+    for (int i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[i * 4 + 1] << 16) | ((uint32_t)data[i * 4 + 2] << 8) | data[i * 4 + 3];
+    }
+
+    for (int i = 16; i < 64; i++)
+    {
+        uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = sha.state[0], b = sha.state[1], c = sha.state[2], d = sha.state[3],
+             e = sha.state[4], f = sha.state[5], g = sha.state[6], h = sha.state[7];
+
+    for (int i = 0; i < 64; i++)
+    {
+        uint32_t t1 = h + (rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+        uint32_t t2 = (rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    sha.state[0] += a; sha.state[1] += b; sha.state[2] += c; sha.state[3] += d;
+    sha.state[4] += e; sha.state[5] += f; sha.state[6] += g; sha.state[7] += h;
+}
+
+static void sha256Init (Sha256State &sha)
+{
+    static const uint32_t initial[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    memcpy(sha.state, initial, sizeof(initial));
+    sha.length    = 0;
+    sha.blockSize = 0;
+}
+
+static void sha256Update (Sha256State &sha, const unsigned char* data, size_t size)
+{
+    sha.length += size;
+
+    while (size > 0)
+    {
+        size_t copy = std::min(size, sizeof(sha.block) - sha.blockSize);
+
+        memcpy(sha.block + sha.blockSize, data, copy);
+        sha.blockSize += copy;
+        data += copy;
+        size -= copy;
+
+        if (sha.blockSize == sizeof(sha.block))
+        {
+            sha256Transform(sha, sha.block);
+            sha.blockSize = 0;
+        }
+    }
+}
+
+static std::string sha256Final (Sha256State &sha)
+{
+    uint64_t      bitLength = sha.length * 8;
+    unsigned char padding[72] = { 0x80 };
+    size_t        paddingSize = (sha.blockSize < 56) ? (56 - sha.blockSize) : (120 - sha.blockSize);
+
+    for (int i = 0; i < 8; i++)
+    {
+        padding[paddingSize + i] = (unsigned char)(bitLength >> (56 - 8 * i));
+    }
+
+    sha256Update(sha, padding, paddingSize + 8);
+
+    char hex[65];
+
+    for (int i = 0; i < 8; i++)
+    {
+        snprintf(hex + i * 8, 9, "%08x", sha.state[i]);
+    }
+
+    return std::string(hex, 64);
+}
+
+///
+/// File helpers
+///
+
+// Create a directory and all of its missing parents
+static bool makeDirectories (std::string path)
+{
+    for (size_t i = 1; i <= path.size(); i++)
+    {
+        if (i == path.size() || path[i] == '/')
+        {
+            std::string current = path.substr(0, i);
+
+            if (mkdir(current.c_str(), 0755) != 0 && errno != EEXIST)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool writeFile (std::string path, const std::string &contents)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = (fwrite(contents.data(), 1, contents.size(), file) == contents.size());
+
+    return (fclose(file) == 0) && written;
+}
+
+static long long fileSize (std::string path)
+{
+    struct stat info;
+
+    return (stat(path.c_str(), &info) == 0) ? (long long)info.st_size : -1;
+}
+
+///
+/// ReplayArchiver
+///
+
+ReplayArchiver::ReplayArchiver () :
+    resultCount(0),
+    abandoning(false),
+    stopping(false),
+    nextJobID(1)
+{}
+
+ReplayArchiver::~ReplayArchiver ()
+{
+    stop();
+}
+
+void ReplayArchiver::start (std::string _replayDirectory, std::string _archiveDirectory)
+{
+    stop();
+
+    replayDirectory  = _replayDirectory;
+    archiveDirectory = _archiveDirectory;
+    stopping         = false;
+    abandoning       = false;
+
+    worker = std::thread(&ReplayArchiver::run, this);
+}
+
+// Stop the worker after it has finished the jobs that are already queued. When 'finishQueued' is false, the replay
+// being compressed is left as it was and the jobs that haven't started are handed back through collect() as failures
+// right away, so stopping doesn't wait on the disk.
+void ReplayArchiver::stop (bool finishQueued)
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+
+    std::deque<Job> abandoned;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+
+        if (!finishQueued)
+        {
+            abandoning = true;
+            abandoned.swap(jobs);
+        }
+    }
+
+    wake.notify_one();
+    worker.join();
+
+    for (const Job &job : abandoned)
+    {
+        Result result;
+        result.jobID          = job.jobID;
+        result.success        = false;
+        result.fileName       = job.fileName;
+        result.error          = "archiving was abandoned";
+        result.originalSize   = 0;
+        result.compressedSize = 0;
+
+        // The replay stays where BZFS saved it, so its index goes there too
+        if (!job.index.empty() && writeFile(replayDirectory + "/" + job.fileName + ".idx", job.index))
+        {
+            result.indexPath = replayDirectory + "/" + job.fileName + ".idx";
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(result);
+        resultCount++;
+    }
+}
+
+bool ReplayArchiver::running (void)
+{
+    return worker.joinable();
+}
+
+// Queue a replay to be archived along with the contents of its sidecar index, if it has one
+int ReplayArchiver::queue (std::string fileName, int year, int month, int day, std::string index)
+{
+    Job job;
+    job.fileName = fileName;
+    job.index    = index;
+    job.year     = year;
+    job.month    = month;
+    job.day      = day;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        job.jobID = nextJobID++;
+        jobs.push_back(job);
+    }
+
+    wake.notify_one();
+
+    return job.jobID;
+}
+
+// Get the result of a finished job without blocking; returns false if nothing has finished
+bool ReplayArchiver::collect (Result &result)
+{
+    // Avoid taking the lock every tick when there's nothing to collect
+    if (resultCount.load() == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (results.empty())
+    {
+        return false;
+    }
+
+    result = results.front();
+    results.pop_front();
+    resultCount--;
+
+    return true;
+}
+
+void ReplayArchiver::run (void)
+{
+    while (true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (jobs.empty() && !stopping)
+            {
+                wake.wait(lock);
+            }
+
+            if (jobs.empty())
+            {
+                return;
+            }
+
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        Result result;
+        archive(job, result);
+
+        // The index belongs next to the replay, wherever the replay ended up
+        if (!job.index.empty())
+        {
+            std::string replayPath = (result.success) ? result.archivedPath.substr(0, result.archivedPath.size() - 3) : replayDirectory + "/" + job.fileName;
+
+            if (writeFile(replayPath + ".idx", job.index))
+            {
+                result.indexPath = replayPath + ".idx";
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(result);
+        resultCount++;
+    }
+}
+
+void ReplayArchiver::archive (const Job &job, Result &result)
+{
+    result.jobID          = job.jobID;
+    result.success        = false;
+    result.fileName       = job.fileName;
+    result.originalSize   = 0;
+    result.compressedSize = 0;
+
+    char datedDirectory[32];
+    snprintf(datedDirectory, sizeof(datedDirectory), "/%04d/%02d/%02d", job.year, job.month, job.day);
+
+    std::string sourcePath    = replayDirectory + "/" + job.fileName,
+                directory     = archiveDirectory + datedDirectory,
+                archivedPath  = directory + "/" + job.fileName + ".gz",
+                temporaryPath = archivedPath + ".tmp";
+
+    if (!makeDirectories(directory))
+    {
+        result.error = "could not create " + directory + ": " + strerror(errno);
+        return;
+    }
+
+    FILE* source = fopen(sourcePath.c_str(), "rb");
+
+    if (!source)
+    {
+        result.error = "could not open " + sourcePath + ": " + strerror(errno);
+        return;
+    }
+
+    gzFile destination = gzopen(temporaryPath.c_str(), "wb9");
+
+    if (!destination)
+    {
+        fclose(source);
+        result.error = "could not create " + temporaryPath;
+        return;
+    }
+
+    Sha256State   sha;
+    unsigned char buffer[65536];
+    size_t        bytesRead;
+    bool          writeFailed = false;
+
+    sha256Init(sha);
+
+    while ((bytesRead = fread(buffer, 1, sizeof(buffer), source)) > 0)
+    {
+        if (abandoning.load())
+        {
+            writeFailed = true;
+            break;
+        }
+
+        sha256Update(sha, buffer, bytesRead);
+        result.originalSize += bytesRead;
+
+        if (gzwrite(destination, buffer, bytesRead) != (int)bytesRead)
+        {
+            writeFailed = true;
+            break;
+        }
+    }
+
+    bool readFailed = ferror(source);
+
+    fclose(source);
+
+    if (gzclose(destination) != Z_OK || writeFailed || readFailed)
+    {
+        remove(temporaryPath.c_str());
+        result.error = (abandoning.load()) ? "archiving was abandoned" : "could not compress " + sourcePath;
+        return;
+    }
+
+    if (rename(temporaryPath.c_str(), archivedPath.c_str()) != 0)
+    {
+        remove(temporaryPath.c_str());
+        result.error = "could not move the replay to " + archivedPath + ": " + strerror(errno);
+        return;
+    }
+
+    // The compressed copy is safely in the archive so the original is no longer needed
+    remove(sourcePath.c_str());
+
+    result.success        = true;
+    result.archivedPath   = archivedPath;
+    result.hash           = sha256Final(sha);
+    result.compressedSize = fileSize(archivedPath);
+}
\ No newline at end of file
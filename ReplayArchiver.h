@@ -0,0 +1,91 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __REPLAY_ARCHIVER_H__
+#define __REPLAY_ARCHIVER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Compresses, hashes and files away saved replays on a background thread so none of the disk work happens on the
+// BZFS main loop. The worker never touches the BZFS API; finished jobs are handed back through collect(), which the
+// plug-in calls from its tick handler.
+class ReplayArchiver
+{
+    public:
+        struct Result
+        {
+            int         jobID;
+
+            bool        success;
+
+            std::string fileName,       // The name of the replay as it was saved by BZFS
+                        archivedPath,   // Where the compressed replay was moved to
+                        indexPath,      // Where the replay's sidecar index was written to, if it had one
+                        hash,           // The SHA-256 of the uncompressed replay
+                        error;          // What went wrong if the job failed
+
+            long long   originalSize,
+                        compressedSize;
+        };
+
+        ReplayArchiver ();
+        ~ReplayArchiver ();
+
+        void start   (std::string replayDirectory, std::string archiveDirectory);
+        void stop    (bool finishQueued = true);
+        bool running (void);
+
+        int  queue   (std::string fileName, int year, int month, int day, std::string index = "");
+        bool collect (Result &result);
+
+    private:
+        struct Job
+        {
+            int         jobID,
+                        year,
+                        month,
+                        day;
+
+            std::string fileName,
+                        index;
+        };
+
+        std::string             replayDirectory,
+                                archiveDirectory;
+
+        std::thread             worker;
+        std::mutex              mutex;
+        std::condition_variable wake;
+        std::deque<Job>         jobs;
+        std::deque<Result>      results;
+        std::atomic<int>        resultCount;
+        std::atomic<bool>       abandoning;
+
+        bool                    stopping;
+        int                     nextJobID;
+
+        void run     (void);
+        void archive (const Job &job, Result &result);
+};
+
+#endif
\ No newline at end of file
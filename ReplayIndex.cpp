@@ -0,0 +1,118 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "JsonWriter.h"
+#include "ReplayIndex.h"
+
+ReplayIndex::ReplayIndex () :
+    recordingStarted(0),
+    recording(false)
+{}
+
+// Start a new index for a recording that started at the given server time
+void ReplayIndex::start (double _recordingStarted)
+{
+    entries.clear();
+
+    recordingStarted = _recordingStarted;
+    recording        = true;
+}
+
+void ReplayIndex::clear (void)
+{
+    entries.clear();
+    recording = false;
+}
+
+void ReplayIndex::record (IndexEventType type, double eventTime, std::string bzID, std::string otherBZID, int team)
+{
+    // Events that happen while nothing is being recorded have nothing to point to
+    if (!recording)
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.offset    = (eventTime > recordingStarted) ? (unsigned int)((eventTime - recordingStarted) * 1000) : 0;
+    entry.type      = type;
+    entry.bzID      = bzID;
+    entry.otherBZID = otherBZID;
+    entry.team      = team;
+
+    entries.push_back(entry);
+}
+
+bool ReplayIndex::empty (void)
+{
+    return entries.empty();
+}
+
+std::string ReplayIndex::serialize (std::string replayName)
+{
+    JsonWriter json(64 + entries.size() * 32);
+
+    json.beginObject()
+            .set("version", 1)
+            .set("replay", replayName)
+            .key("events").beginArray();
+
+    for (unsigned int i = 0; i < entries.size(); i++)
+    {
+        const Entry &entry = entries.at(i);
+
+        json.beginArray()
+                .value((long long)entry.offset)
+                .value(indexEventTypeToString(entry.type))
+                .value(entry.bzID)
+                .value(entry.otherBZID)
+                .value(entry.team)
+            .endArray();
+    }
+
+    json.endArray()
+        .endObject();
+
+    return json.str();
+}
+
+const char* ReplayIndex::indexEventTypeToString (IndexEventType type)
+{
+    switch (type)
+    {
+        case CAPTURE:
+            return "capture";
+
+        case PAUSE:
+            return "pause";
+
+        case RESUME:
+            return "resume";
+
+        case KILL:
+            return "kill";
+
+        case SUB_IN:
+            return "sub-in";
+
+        case SUB_OUT:
+            return "sub-out";
+
+        default:
+            return "noEvent";
+    }
+}
\ No newline at end of file
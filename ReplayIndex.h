@@ -0,0 +1,77 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __REPLAY_INDEX_H__
+#define __REPLAY_INDEX_H__
+
+#include <string>
+#include <vector>
+
+// An index of the events that happened while a replay was being recorded. It's saved next to the replay as a
+// sidecar file (<replay>.idx) so tools can jump straight to a moment without decoding the whole replay.
+//
+// The file is a single JSON object:
+//     {"version":1,"replay":"offi-...rec","events":[[offset,"type","bzid","other bzid",team],...]}
+//
+// where 'offset' is the number of milliseconds since the recording started.
+class ReplayIndex
+{
+    public:
+        enum IndexEventType
+        {
+            CAPTURE,
+            PAUSE,
+            RESUME,
+            KILL,
+            SUB_IN,
+            SUB_OUT,
+            LAST_INDEX_EVENT_TYPE
+        };
+
+        ReplayIndex ();
+
+        void start  (double recordingStarted);
+        void clear  (void);
+        void record (IndexEventType type, double eventTime, std::string bzID, std::string otherBZID = "", int team = -1);
+
+        bool        empty     (void);
+        std::string serialize (std::string replayName);
+
+    private:
+        struct Entry
+        {
+            unsigned int   offset;
+
+            IndexEventType type;
+
+            std::string    bzID,
+                           otherBZID;
+
+            int            team;
+        };
+
+        std::vector<Entry> entries;
+
+        double recordingStarted;
+
+        bool   recording;
+
+        const char* indexEventTypeToString (IndexEventType type);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "ReplayRetention.h"
+
+static bool endsWith (const std::string &str, const char* suffix)
+{
+    std::string ending(suffix);
+
+    return str.size() >= ending.size() && str.compare(str.size() - ending.size(), ending.size(), ending) == 0;
+}
+
+// The sidecar index of a replay is named after the uncompressed replay, even when the replay has been archived
+static std::string indexPathFor (std::string path)
+{
+    if (endsWith(path, ".gz"))
+    {
+        path.erase(path.size() - 3);
+    }
+
+    return path + ".idx";
+}
+
+ReplayRetention::ReplayRetention () :
+    evictionCount(0),
+    stopping(false)
+{}
+
+ReplayRetention::~ReplayRetention ()
+{
+    stop();
+}
+
+void ReplayRetention::start (std::vector<std::string> _directories, Budget funBudget, Budget officialBudget)
+{
+    stop();
+
+    directories = _directories;
+    stopping    = false;
+
+    fun.budget          = funBudget;
+    fun.totalBytes      = 0;
+    official.budget     = officialBudget;
+    official.totalBytes = 0;
+
+    fun.replays.clear();
+    official.replays.clear();
+    indexed.clear();
+
+    worker = std::thread(&ReplayRetention::run, this);
+}
+
+void ReplayRetention::stop (void)
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+}
+
+bool ReplayRetention::running (void)
+{
+    return worker.joinable();
+}
+
+// Add a replay that was just saved or archived to the index and make room for it
+void ReplayRetention::track (std::string path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(path);
+    }
+
+    wake.notify_one();
+}
+
+// Get a replay that was removed without blocking; returns false if nothing has been removed
+bool ReplayRetention::collect (Eviction &eviction)
+{
+    if (evictionCount.load() == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (evictions.empty())
+    {
+        return false;
+    }
+
+    eviction = evictions.front();
+    evictions.pop_front();
+    evictionCount--;
+
+    return true;
+}
+
+void ReplayRetention::run (void)
+{
+    // Build the index once; the directories are never walked again while the worker is running
+    for (auto directory : directories)
+    {
+        scan(directory);
+    }
+
+    enforce(fun);
+    enforce(official);
+
+    while (true)
+    {
+        std::string path;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (pending.empty() && !stopping)
+            {
+                wake.wait(lock);
+            }
+
+            if (pending.empty())
+            {
+                return;
+            }
+
+            path = pending.front();
+            pending.pop_front();
+        }
+
+        Category* category = classify(path);
+
+        if (category)
+        {
+            add(path);
+            enforce(*category);
+        }
+    }
+}
+
+void ReplayRetention::scan (std::string directory)
+{
+    DIR* handle = opendir(directory.c_str());
+
+    if (!handle)
+    {
+        return;
+    }
+
+    struct dirent* entry;
+
+    while ((entry = readdir(handle)) != NULL)
+    {
+        std::string name = entry->d_name;
+
+        if (name == "." || name == "..")
+        {
+            continue;
+        }
+
+        std::string path = directory + "/" + name;
+        struct stat info;
+
+        if (lstat(path.c_str(), &info) != 0)
+        {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode))
+        {
+            scan(path);
+        }
+        else if (S_ISREG(info.st_mode))
+        {
+            add(path);
+        }
+    }
+
+    closedir(handle);
+}
+
+void ReplayRetention::add (std::string path)
+{
+    Category* category = classify(path);
+    struct stat info;
+
+    // The archive may live inside of the replay directory so the same replay could be found twice
+    if (!category || indexed.count(path) || stat(path.c_str(), &info) != 0)
+    {
+        return;
+    }
+
+    Replay replay;
+    replay.path     = path;
+    replay.modified = (long long)info.st_mtime;
+    replay.size     = (long long)info.st_size;
+
+    struct stat sidecar;
+
+    if (stat(indexPathFor(path).c_str(), &sidecar) == 0)
+    {
+        replay.size += (long long)sidecar.st_size;
+    }
+
+    category->replays.insert(replay);
+    category->totalBytes += replay.size;
+    indexed.insert(path);
+}
+
+// Remove the oldest replays of a category until it's back within its budget. The newest replay is always kept so a
+// budget that's smaller than a single match doesn't delete the replay that was just saved.
+void ReplayRetention::enforce (Category &category)
+{
+    while (category.replays.size() > 1)
+    {
+        bool overCount = (category.budget.maxCount > 0 && (int)category.replays.size() > category.budget.maxCount);
+        bool overBytes = (category.budget.maxBytes > 0 && category.totalBytes > category.budget.maxBytes);
+
+        if (!overCount && !overBytes)
+        {
+            break;
+        }
+
+        Replay oldest = *category.replays.begin();
+
+        category.replays.erase(category.replays.begin());
+        category.totalBytes -= oldest.size;
+        indexed.erase(oldest.path);
+
+        // A replay that has already disappeared still has to leave the index, otherwise the budget would never be met
+        remove(oldest.path.c_str());
+        remove(indexPathFor(oldest.path).c_str());
+
+        Eviction eviction;
+        eviction.path = oldest.path;
+        eviction.size = oldest.size;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        evictions.push_back(eviction);
+        evictionCount++;
+    }
+}
+
+// Only the replays the plug-in saves are managed; any other recordings in the directory are left alone
+ReplayRetention::Category* ReplayRetention::classify (std::string path)
+{
+    if (!endsWith(path, ".rec") && !endsWith(path, ".rec.gz"))
+    {
+        return NULL;
+    }
+
+    std::string name = path.substr(path.find_last_of('/') + 1);
+
+    if (name.compare(0, 4, "fun-") == 0)
+    {
+        return &fun;
+    }
+
+    if (name.compare(0, 5, "offi-") == 0)
+    {
+        return &official;
+    }
+
+    return NULL;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __REPLAY_RETENTION_H__
+#define __REPLAY_RETENTION_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Keeps the fun and official replays on disk within their size and count budgets. The replay directories are only
+// scanned once when the worker starts; after that the index is kept up to date with the replays the plug-in saves, so
+// evicting the oldest replays never needs another walk of the disk. Like the archiver, the worker never touches the
+// BZFS API and the replays it removed are handed back through collect().
+class ReplayRetention
+{
+    public:
+        struct Budget
+        {
+            long long maxBytes;     // 0 for no limit
+            int       maxCount;     // 0 for no limit
+        };
+
+        struct Eviction
+        {
+            std::string path;
+            long long   size;
+        };
+
+        ReplayRetention ();
+        ~ReplayRetention ();
+
+        void start   (std::vector<std::string> directories, Budget funBudget, Budget officialBudget);
+        void stop    (void);
+        bool running (void);
+
+        void track   (std::string path);
+        bool collect (Eviction &eviction);
+
+    private:
+        struct Replay
+        {
+            long long   modified,
+                        size;
+            std::string path;
+
+            bool operator< (const Replay &other) const
+            {
+                return (modified != other.modified) ? (modified < other.modified) : (path < other.path);
+            }
+        };
+
+        struct Category
+        {
+            Budget           budget;
+            std::set<Replay> replays;   // Oldest first
+            long long        totalBytes;
+        };
+
+        std::vector<std::string> directories;
+
+        Category                 fun,
+                                 official;
+        std::set<std::string>    indexed;
+
+        std::thread              worker;
+        std::mutex               mutex;
+        std::condition_variable  wake;
+        std::deque<std::string>  pending;
+        std::deque<Eviction>     evictions;
+        std::atomic<int>         evictionCount;
+
+        bool                     stopping;
+
+        void      run      (void);
+        void      scan     (std::string directory);
+        void      add      (std::string path);
+        void      enforce  (Category &category);
+        Category* classify (std::string path);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,344 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ReportRelay.h"
+
+ReportRelay::ReportRelay () :
+    fd(-1),
+    nextID(1),
+    nextReconnect(0),
+    queued(0),
+    sent(0)
+{}
+
+ReportRelay::~ReportRelay ()
+{
+    disconnect();
+}
+
+bool ReportRelay::connect (std::string _socketPath)
+{
+    disconnect();
+
+    socketPath = _socketPath;
+
+    return open();
+}
+
+// Close the connection without waiting on the daemon. The requests it already has are still sent to the league site,
+// but their answers will never be read so their handlers are told they timed out. The ones it didn't get in full are
+// handed to BZFS to send instead.
+void ReportRelay::disconnect (void)
+{
+    flush();
+
+    std::map<uint32_t, Pending> unsent;
+
+    for (auto request = pending.begin(); request != pending.end(); )
+    {
+        if (request->second.end > sent)
+        {
+            unsent.insert(*request);
+            request = pending.erase(request);
+        }
+        else
+        {
+            ++request;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    fd = -1;
+    socketPath.clear();
+    inbound.clear();
+    outbound.clear();
+
+    abandon();
+
+    for (auto &request : unsent)
+    {
+        bz_addURLJob(request.second.url.c_str(), request.second.handler, request.second.postData.c_str());
+    }
+}
+
+bool ReportRelay::enabled (void)
+{
+    return !socketPath.empty();
+}
+
+bool ReportRelay::connected (void)
+{
+    return (fd >= 0);
+}
+
+bool ReportRelay::submit (const char* url, const std::string &postData, bz_BaseURLHandler* handler)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    size_t urlLength = strlen(url);
+
+    RelayFrame frame;
+    memset(&frame, 0, sizeof(frame));
+
+    frame.length = urlLength + 1 + postData.size();
+    frame.id     = nextID++;
+    frame.type   = RELAY_REQUEST;
+
+    if (frame.length > RELAY_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    outbound.append((const char*)&frame, sizeof(frame));
+    outbound.append(url, urlLength + 1);
+    outbound.append(postData);
+    queued += sizeof(frame) + frame.length;
+
+    flush();
+
+    // If the connection dropped while writing, the daemon never got the whole request. It isn't pending yet so drop()
+    // didn't answer it, and the caller can send it itself.
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    Pending request;
+    request.url      = url;
+    request.postData = postData;
+    request.handler  = handler;
+    request.end      = queued;
+
+    pending[frame.id] = request;
+
+    return true;
+}
+
+// Called every tick: write what's left over, read the answers the daemon has sent and reconnect if we lost it
+void ReportRelay::poll (void)
+{
+    if (fd < 0)
+    {
+        if (enabled() && time(NULL) >= nextReconnect)
+        {
+            open();
+        }
+
+        return;
+    }
+
+    flush();
+
+    char buffer[16384];
+    ssize_t bytesRead;
+
+    while (fd >= 0 && (bytesRead = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+    {
+        inbound.append(buffer, bytesRead);
+    }
+
+    if (fd >= 0 && (bytesRead == 0 || (bytesRead < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)))
+    {
+        drop();
+        return;
+    }
+
+    // A handler may send another request and lose the connection doing it, which clears inbound; walk our own copy
+    std::string received;
+    received.swap(inbound);
+
+    size_t offset = 0;
+
+    while (received.size() - offset >= sizeof(RelayFrame))
+    {
+        RelayFrame frame;
+        memcpy(&frame, received.data() + offset, sizeof(frame));
+
+        if (frame.length > RELAY_MAX_PAYLOAD)
+        {
+            drop();
+            return;
+        }
+
+        if (received.size() - offset - sizeof(frame) < frame.length)
+        {
+            break;
+        }
+
+        dispatch(frame, received.data() + offset + sizeof(frame));
+        offset += sizeof(frame) + frame.length;
+
+        // drop() has already answered everything that was waiting, so the rest of the frames are for nobody
+        if (fd < 0)
+        {
+            return;
+        }
+    }
+
+    inbound = received.substr(offset);
+}
+
+bool ReportRelay::open (void)
+{
+    // Don't hammer a daemon that isn't running
+    nextReconnect = time(NULL) + 30;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+
+    strcpy(address.sun_path, socketPath.c_str());
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (::connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    queued = sent = 0;
+
+    return true;
+}
+
+void ReportRelay::flush (void)
+{
+    while (fd >= 0 && !outbound.empty())
+    {
+        ssize_t written = send(fd, outbound.data(), outbound.size(), MSG_NOSIGNAL);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                drop();
+            }
+
+            return;
+        }
+
+        outbound.erase(0, written);
+        sent += written;
+    }
+}
+
+void ReportRelay::dispatch (const RelayFrame &frame, const char* payload)
+{
+    std::map<uint32_t, Pending>::iterator request = pending.find(frame.id);
+
+    if (frame.type != RELAY_RESPONSE || request == pending.end())
+    {
+        return;
+    }
+
+    // The handler may submit another request, so don't hold on to the iterator
+    Pending answered = request->second;
+    pending.erase(request);
+
+    // Nobody is waiting on the answers to requests that were sent without a handler
+    if (!answered.handler)
+    {
+        return;
+    }
+
+    std::string body(payload, frame.length);
+
+    switch (frame.status)
+    {
+        case RELAY_OK:
+        {
+            // An empty answer is still an answer; the handler has to hear about it or it never finishes
+            answered.handler->URLDone(answered.url.c_str(), body.c_str(), body.size(), true);
+        }
+        break;
+
+        case RELAY_TIMEOUT:
+        {
+            answered.handler->URLTimeout(answered.url.c_str(), frame.code);
+        }
+        break;
+
+        default:
+        {
+            answered.handler->URLError(answered.url.c_str(), frame.code, body.c_str());
+        }
+        break;
+    }
+}
+
+// We lost the daemon; there's no telling whether it sent the requests we were waiting on so treat them as timed out
+void ReportRelay::drop (void)
+{
+    close(fd);
+    fd = -1;
+
+    inbound.clear();
+    outbound.clear();
+    nextReconnect = time(NULL) + 30;
+
+    abandon();
+}
+
+// Tell everyone still waiting on an answer that it isn't coming. A handler may be waiting to free itself when it's
+// answered, so the requests can't just be forgotten.
+void ReportRelay::abandon (void)
+{
+    std::map<uint32_t, Pending> lost;
+    lost.swap(pending);
+
+    for (auto &request : lost)
+    {
+        if (request.second.handler)
+        {
+            request.second.handler->URLTimeout(request.second.url.c_str(), 0);
+        }
+    }
+}
\ No newline at end of file
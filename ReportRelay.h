@@ -0,0 +1,77 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __REPORT_RELAY_H__
+#define __REPORT_RELAY_H__
+
+#include <ctime>
+#include <map>
+#include <string>
+
+#include "bzfsAPI.h"
+
+#include "ReportRelayProtocol.h"
+
+// The plug-in's end of the connection to the LeagueOverseerRelay daemon. Requests are handed to the daemon instead
+// of being sent to the league site by BZFS; the answers are read back in poll() and passed to the same
+// bz_BaseURLHandler a URL job would have called. The socket never blocks the main loop, and if the daemon can't be
+// reached submit() returns false so the caller can send the request itself.
+class ReportRelay
+{
+    public:
+        ReportRelay ();
+        ~ReportRelay ();
+
+        bool connect    (std::string socketPath);
+        void disconnect (void);
+        bool enabled    (void);
+        bool connected  (void);
+
+        bool submit     (const char* url, const std::string &postData, bz_BaseURLHandler* handler);
+        void poll       (void);
+
+    private:
+        // A request stays here until it's answered. It reached the daemon once the first "end" bytes were written.
+        struct Pending
+        {
+            std::string        url,
+                               postData;
+            bz_BaseURLHandler* handler;
+            uint64_t           end;
+        };
+
+        std::string                  socketPath,
+                                     inbound,
+                                     outbound;
+
+        std::map<uint32_t, Pending>  pending;
+
+        int                          fd;
+        uint32_t                     nextID;
+        time_t                       nextReconnect;
+        uint64_t                     queued,
+                                     sent;
+
+        bool open     (void);
+        void flush    (void);
+        void dispatch (const RelayFrame &frame, const char* payload);
+        void drop     (void);
+        void abandon  (void);
+};
+
+#endif
\ No newline at end of file
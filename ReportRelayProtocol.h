@@ -0,0 +1,60 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __REPORT_RELAY_PROTOCOL_H__
+#define __REPORT_RELAY_PROTOCOL_H__
+
+#include <cstdint>
+
+// The messages passed between the plug-in and the LeagueOverseerRelay daemon over its Unix domain socket. Both ends
+// run on the same host so the fields are in host byte order. Every message is a RelayFrame followed by 'length' bytes
+// of payload:
+//
+//     RELAY_REQUEST   the URL, a NUL byte, then the POST data
+//     RELAY_RESPONSE  the body returned by the league site, or an error message if 'status' isn't RELAY_OK
+//
+// The 'id' of a response is the 'id' of the request it answers.
+
+#define RELAY_MAX_PAYLOAD (4 * 1024 * 1024)
+
+enum RelayFrameType
+{
+    RELAY_REQUEST = 1,
+    RELAY_RESPONSE
+};
+
+enum RelayStatus
+{
+    RELAY_OK = 0,
+    RELAY_ERROR,        // 'code' holds the HTTP status or transport error
+    RELAY_TIMEOUT
+};
+
+struct RelayFrame
+{
+    uint32_t length,
+             id;
+    uint8_t  type,
+             status;
+    uint16_t reserved;
+    int32_t  code;
+};
+
+static_assert(sizeof(RelayFrame) == 16, "Relay frames must stay 16 bytes");
+
+#endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SharedTeamCache.h"
+
+static const uint32_t TEAM_CACHE_MAGIC    = 0x4c4f5443; // "LOTC"
+static const uint32_t TEAM_CACHE_VERSION  = 1;
+static const uint32_t TEAM_CACHE_CAPACITY = 16384;      // The most BZIDs the table can hold
+static const uint32_t TEAM_CACHE_POOL     = 262144;     // The number of bytes set aside for team names
+static const int      TEAM_CACHE_ATTEMPTS = 64;         // The most times a reader tries to get a consistent read
+
+SharedTeamCache::SharedTeamCache () :
+    fd(-1),
+    writer(false),
+    size(0),
+    header(NULL),
+    entries(NULL),
+    pool(NULL)
+{}
+
+SharedTeamCache::~SharedTeamCache ()
+{
+    detach();
+}
+
+// Open (or create) the segment and map it; we'll become the writer if no other instance is
+bool SharedTeamCache::attach (std::string name)
+{
+    detach();
+
+    fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    size = sizeof(Header) + TEAM_CACHE_CAPACITY * sizeof(Entry) + TEAM_CACHE_POOL;
+
+    struct stat info;
+
+    // Every instance asks for the same size so it doesn't matter which one of them creates the segment
+    if (fstat(fd, &info) != 0 || ((size_t)info.st_size < size && ftruncate(fd, size) != 0))
+    {
+        detach();
+        return false;
+    }
+
+    void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (base == MAP_FAILED)
+    {
+        detach();
+        return false;
+    }
+
+    header  = (Header*)base;
+    entries = (Entry*)((char*)base + sizeof(Header));
+    pool    = (char*)(entries + TEAM_CACHE_CAPACITY);
+
+    elect();
+
+    return true;
+}
+
+void SharedTeamCache::detach (void)
+{
+    if (header)
+    {
+        munmap(header, size);
+    }
+
+    // Closing the descriptor releases our lock so another instance can take over as the writer
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    fd      = -1;
+    writer  = false;
+    header  = NULL;
+    entries = NULL;
+    pool    = NULL;
+}
+
+bool SharedTeamCache::attached (void)
+{
+    return (header != NULL);
+}
+
+// Try to become the writer; returns true only when this instance has just taken over
+bool SharedTeamCache::elect (void)
+{
+    if (!header || writer || flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        return false;
+    }
+
+    if (mprotect(header, size, PROT_READ | PROT_WRITE) != 0)
+    {
+        flock(fd, LOCK_UN);
+        return false;
+    }
+
+    writer = true;
+
+    // A brand new segment is all zeroes, which readers already treat as an empty table
+    if (header->magic != TEAM_CACHE_MAGIC || header->version != TEAM_CACHE_VERSION)
+    {
+        header->sequence.store(0);
+        header->entryCount  = 0;
+        header->poolSize    = 0;
+        header->refreshedAt = 0;
+        header->version     = TEAM_CACHE_VERSION;
+        header->magic       = TEAM_CACHE_MAGIC;
+    }
+
+    // An odd sequence means the last writer died in the middle of publishing. What it left behind may be torn, so
+    // empty the table and mark it stale; readers would otherwise wait forever for the sequence to become even.
+    uint32_t sequence = header->sequence.load(std::memory_order_relaxed);
+
+    if (sequence & 1)
+    {
+        header->entryCount  = 0;
+        header->poolSize    = 0;
+        header->refreshedAt = 0;
+
+        header->sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    return true;
+}
+
+bool SharedTeamCache::isWriter (void)
+{
+    return writer;
+}
+
+// Whether or not the table is older than 'maxAge' seconds
+bool SharedTeamCache::isStale (int maxAge)
+{
+    return !header || header->magic != TEAM_CACHE_MAGIC || (time(NULL) - header->refreshedAt) >= maxAge;
+}
+
+// Replace the whole table with a new dump; only the writer may call this. Returns false if the dump didn't fit, in
+// which case as much of it as possible was published.
+bool SharedTeamCache::publish (const std::map<std::string, std::string> &teamNames)
+{
+    if (!writer)
+    {
+        return false;
+    }
+
+    uint32_t current = header->sequence.load(std::memory_order_relaxed);
+
+    header->sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Teams have several members so each name is only stored once
+    std::map<std::string, uint32_t> offsets;
+    uint32_t entryCount = 0, poolSize = 0;
+    bool     complete = true;
+
+    // std::map iterates in the same byte order strcmp() uses, so the table comes out sorted for lookup()
+    for (auto &player : teamNames)
+    {
+        if (player.second.empty())
+        {
+            continue;
+        }
+
+        if (entryCount == TEAM_CACHE_CAPACITY || player.first.size() >= sizeof(entries[0].bzID))
+        {
+            complete = false;
+            continue;
+        }
+
+        auto offset = offsets.find(player.second);
+
+        if (offset == offsets.end())
+        {
+            if (poolSize + player.second.size() + 1 > TEAM_CACHE_POOL)
+            {
+                complete = false;
+                continue;
+            }
+
+            memcpy(pool + poolSize, player.second.c_str(), player.second.size() + 1);
+            offset = offsets.insert(std::make_pair(player.second, poolSize)).first;
+            poolSize += player.second.size() + 1;
+        }
+
+        memset(entries[entryCount].bzID, 0, sizeof(entries[entryCount].bzID));
+        memcpy(entries[entryCount].bzID, player.first.c_str(), player.first.size());
+        entries[entryCount].teamName = offset->second;
+        entryCount++;
+    }
+
+    header->entryCount  = entryCount;
+    header->poolSize    = poolSize;
+    header->refreshedAt = (int64_t)time(NULL);
+
+    header->sequence.store(current + 2, std::memory_order_release);
+
+    return complete;
+}
+
+// Look up a team name without blocking the writer. Readers give up after a few attempts rather than spinning on the
+// server's thread, so a lookup that overlaps a publish may come back BUSY.
+SharedTeamCache::LookupResult SharedTeamCache::lookup (const std::string &bzID, std::string &teamName)
+{
+    if (!header || bzID.empty())
+    {
+        return NOT_FOUND;
+    }
+
+    uint32_t before, after;
+    bool     found;
+
+    for (int attempt = 0; attempt < TEAM_CACHE_ATTEMPTS; attempt++)
+    {
+        if (attempt > 0)
+        {
+            sched_yield();
+        }
+
+        before = header->sequence.load(std::memory_order_acquire);
+        found  = false;
+
+        if (header->magic == TEAM_CACHE_MAGIC)
+        {
+            // The counts are clamped because they may be read mid-update; the sequence check throws such reads away
+            uint32_t low = 0, high = std::min(header->entryCount, TEAM_CACHE_CAPACITY), poolSize = std::min(header->poolSize, TEAM_CACHE_POOL);
+
+            while (low < high)
+            {
+                uint32_t middle     = low + (high - low) / 2;
+                int      comparison = strncmp(entries[middle].bzID, bzID.c_str(), sizeof(entries[middle].bzID));
+
+                if (comparison == 0)
+                {
+                    uint32_t offset = entries[middle].teamName;
+
+                    if (offset < poolSize)
+                    {
+                        teamName.assign(pool + offset, strnlen(pool + offset, poolSize - offset));
+                        found = true;
+                    }
+
+                    break;
+                }
+
+                if (comparison < 0)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = header->sequence.load(std::memory_order_relaxed);
+
+        if (!(before & 1) && before == after)
+        {
+            return (found) ? FOUND : NOT_FOUND;
+        }
+    }
+
+    return BUSY;
+}
\ No newline at end of file
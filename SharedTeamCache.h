@@ -0,0 +1,85 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SHARED_TEAM_CACHE_H__
+#define __SHARED_TEAM_CACHE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+
+// A table of team names shared by every BZFS instance on the same host through a POSIX shared memory segment. One
+// instance is elected as the writer by holding an exclusive lock on the segment; it downloads the team name dump and
+// publishes it. Every other instance maps the segment read-only and looks names up in place. When the writer exits,
+// its lock is released and the next instance to call elect() takes over.
+//
+// The table is a sorted array of BZIDs, each pointing into a pool of team names, guarded by a sequence lock so readers
+// never block the writer.
+class SharedTeamCache
+{
+    public:
+        enum LookupResult
+        {
+            FOUND,
+            NOT_FOUND,
+            BUSY        // The writer was in the middle of publishing every time we tried to read the table
+        };
+
+        SharedTeamCache ();
+        ~SharedTeamCache ();
+
+        bool attach   (std::string name);
+        void detach   (void);
+        bool attached (void);
+
+        bool elect    (void);
+        bool isWriter (void);
+        bool isStale  (int maxAge);
+
+        bool publish  (const std::map<std::string, std::string> &teamNames);
+        LookupResult lookup (const std::string &bzID, std::string &teamName);
+
+    private:
+        struct Header
+        {
+            uint32_t              magic,
+                                  version;
+            std::atomic<uint32_t> sequence;
+            uint32_t              entryCount,
+                                  poolSize;
+            int64_t               refreshedAt;  // The UTC Unix timestamp of the last dump that was published
+        };
+
+        struct Entry
+        {
+            char     bzID[20];
+            uint32_t teamName;                  // The offset of the team name in the pool
+        };
+
+        int     fd;
+        bool    writer;
+        size_t  size;
+
+        Header* header;
+        Entry*  entries;
+        char*   pool;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel () :
+    currentTick(0),
+    origin(0),
+    started(false),
+    pendingCount(0)
+{
+    for (int &slot : slots)
+    {
+        slot = NONE;
+    }
+}
+
+// Run the callback 'delay' seconds from now, and every 'interval' seconds after that if an interval is given
+TimerWheel::TimerID TimerWheel::schedule (double now, double delay, Callback callback, double interval)
+{
+    // The first timer sets the origin of the wheel's ticks
+    if (!started)
+    {
+        origin  = now;
+        started = true;
+    }
+
+    int index;
+
+    if (freeTimers.empty())
+    {
+        index = timers.size();
+        timers.push_back(Timer());
+        timers[index].generation = 0;
+    }
+    else
+    {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    }
+
+    Timer &timer = timers[index];
+    double   due      = (now + ((delay > 0) ? delay : 0) - origin) / TIMER_WHEEL_RESOLUTION;
+    uint64_t deadline = (due > 0) ? (uint64_t)ceil(due - 1e-9) : 0;
+
+    // A timer never fires on a tick that's already been processed
+    timer.deadline = (deadline > currentTick) ? deadline : currentTick + 1;
+    timer.interval = (interval > 0) ? std::max<uint64_t>(1, llround(interval / TIMER_WHEEL_RESOLUTION)) : 0;
+    timer.prev     = NONE;
+    timer.next     = NONE;
+    timer.slot     = NONE;
+    timer.active   = true;
+    timer.firing   = false;
+    timer.callback = callback;
+
+    link(index);
+    pendingCount++;
+
+    return ((TimerID)timer.generation << 32) | (uint32_t)(index + 1);
+}
+
+// Stop a timer from firing again; returns false if the timer had already fired or been canceled
+bool TimerWheel::cancel (TimerID timerID)
+{
+    int index = (int)(uint32_t)timerID - 1;
+
+    if (index < 0 || index >= (int)timers.size())
+    {
+        return false;
+    }
+
+    Timer &timer = timers[index];
+
+    if (!timer.active || timer.generation != (uint32_t)(timerID >> 32))
+    {
+        return false;
+    }
+
+    timer.active = false;
+    pendingCount--;
+
+    // A timer canceling itself from its own callback is cleaned up once the callback returns
+    if (!timer.firing)
+    {
+        unlink(index);
+        release(index);
+    }
+
+    return true;
+}
+
+// Fire everything that's due by the given time
+void TimerWheel::advance (double now)
+{
+    if (!started)
+    {
+        return;
+    }
+
+    uint64_t target = toTick(now);
+
+    while (currentTick < target)
+    {
+        tick();
+    }
+}
+
+size_t TimerWheel::pending (void) const
+{
+    return pendingCount;
+}
+
+uint64_t TimerWheel::toTick (double time) const
+{
+    return (time > origin) ? (uint64_t)((time - origin) / TIMER_WHEEL_RESOLUTION) : 0;
+}
+
+// Put a timer into the slot of the lowest level whose turn reaches its deadline
+void TimerWheel::link (int index)
+{
+    Timer &timer = timers[index];
+    uint64_t delta = timer.deadline - currentTick;
+    int level = 0;
+
+    while (level < LEVELS - 1 && delta >= (1ULL << (LEVEL_BITS * (level + 1))))
+    {
+        level++;
+    }
+
+    // Anything beyond the last level waits in the furthest slot and is cascaded down until it's in range
+    uint64_t deadline = (level == LEVELS - 1 && delta >= (1ULL << (LEVEL_BITS * LEVELS))) ? currentTick + (1ULL << (LEVEL_BITS * LEVELS)) - 1 : timer.deadline;
+
+    timer.slot = level * LEVEL_SLOTS + (int)((deadline >> (LEVEL_BITS * level)) & (LEVEL_SLOTS - 1));
+    timer.prev = NONE;
+    timer.next = slots[timer.slot];
+
+    if (timer.next != NONE)
+    {
+        timers[timer.next].prev = index;
+    }
+
+    slots[timer.slot] = index;
+}
+
+void TimerWheel::unlink (int index)
+{
+    Timer &timer = timers[index];
+
+    if (timer.slot == NONE)
+    {
+        return;
+    }
+
+    if (timer.prev != NONE)
+    {
+        timers[timer.prev].next = timer.next;
+    }
+    else
+    {
+        slots[timer.slot] = timer.next;
+    }
+
+    if (timer.next != NONE)
+    {
+        timers[timer.next].prev = timer.prev;
+    }
+
+    timer.prev = NONE;
+    timer.next = NONE;
+    timer.slot = NONE;
+}
+
+void TimerWheel::release (int index)
+{
+    timers[index].generation++;
+    timers[index].callback = nullptr;
+    freeTimers.push_back(index);
+}
+
+// Move the timers of the current slot of a level down into the levels below it
+void TimerWheel::cascade (int level)
+{
+    int &slot = slots[level * LEVEL_SLOTS + (int)((currentTick >> (LEVEL_BITS * level)) & (LEVEL_SLOTS - 1))];
+
+    while (slot != NONE)
+    {
+        int index = slot;
+
+        unlink(index);
+        link(index);
+    }
+}
+
+void TimerWheel::tick (void)
+{
+    currentTick++;
+
+    // Each time a level finishes a turn, the next slot of the level above it is spread out over it
+    for (int level = 1; level < LEVELS; level++)
+    {
+        if (((currentTick >> (LEVEL_BITS * (level - 1))) & (LEVEL_SLOTS - 1)) != 0)
+        {
+            break;
+        }
+
+        cascade(level);
+    }
+
+    // The slot can be changed by the callbacks so only ever take the timer at its head
+    int &slot = slots[currentTick & (LEVEL_SLOTS - 1)];
+
+    while (slot != NONE)
+    {
+        int index = slot;
+
+        unlink(index);
+
+        timers[index].firing = true;
+
+        // The callback may schedule new timers, which could move the vector, so don't hold onto a reference
+        Callback callback = std::move(timers[index].callback);
+        callback();
+
+        Timer &timer = timers[index];
+        timer.firing = false;
+
+        if (timer.active && timer.interval > 0)
+        {
+            timer.deadline = currentTick + timer.interval;
+            timer.callback = std::move(callback);
+            link(index);
+        }
+        else
+        {
+            if (timer.active)
+            {
+                timer.active = false;
+                pendingCount--;
+            }
+
+            release(index);
+        }
+    }
+}
\ No newline at end of file
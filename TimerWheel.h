@@ -0,0 +1,89 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// The length of a single tick of the wheel in seconds; timers fire on the first tick at or after their deadline
+#define TIMER_WHEEL_RESOLUTION 0.05
+
+// A hierarchical timing wheel for the work the plug-in needs to do at a later time. There are four levels of 64 slots,
+// each slot of a level covering a whole turn of the level below it, so deadlines up to about nine days away can be
+// held. Scheduling and canceling a timer are O(1), and advancing the wheel only looks at the slot for the current
+// tick (plus the occasional cascade of a higher level slot into the one below it), so the cost of a BZFS tick doesn't
+// grow with the number of pending timers.
+//
+// Callbacks run inside of advance() on the thread calling it and may schedule or cancel timers, including their own.
+class TimerWheel
+{
+    public:
+        typedef uint64_t              TimerID;  // 0 is never a valid timer
+        typedef std::function<void()> Callback;
+
+        TimerWheel ();
+
+        TimerID schedule (double now, double delay, Callback callback, double interval = 0);
+        bool    cancel   (TimerID timerID);
+        void    advance  (double now);
+        size_t  pending  (void) const;
+
+    private:
+        enum
+        {
+            LEVEL_BITS  = 6,
+            LEVEL_SLOTS = 1 << LEVEL_BITS,
+            LEVELS      = 4,
+            NONE        = -1
+        };
+
+        struct Timer
+        {
+            uint64_t deadline,      // The tick the timer fires on
+                     interval;      // The number of ticks between firings for periodic timers; 0 for one-shot timers
+            uint32_t generation;    // Bumped each time the entry is reused so stale IDs can't cancel someone else's timer
+            int      prev,
+                     next,
+                     slot;          // The index into 'slots' of the list the timer is in, or NONE
+            bool     active,
+                     firing;
+            Callback callback;
+        };
+
+        std::vector<Timer> timers;
+        std::vector<int>   freeTimers;
+        int                slots[LEVELS * LEVEL_SLOTS];
+
+        uint64_t           currentTick;
+        double             origin;      // The server time of tick 0
+        bool               started;
+        size_t             pendingCount;
+
+        uint64_t toTick  (double time) const;
+        void     link    (int index);
+        void     unlink  (int index);
+        void     release (int index);
+        void     cascade (int level);
+        void     tick    (void);
+};
+
+#endif
\ No newline at end of file
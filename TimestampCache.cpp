@@ -0,0 +1,80 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+
+#include "TimestampCache.h"
+
+TimestampCache::TimestampCache () :
+    cachedSecond(-1)
+{
+    cachedTime = bz_Time();
+    dateTimeBuffer[0] = fileDateTimeBuffer[0] = '\0';
+}
+
+const bz_Time& TimestampCache::utcTime (void)
+{
+    refresh();
+
+    return cachedTime;
+}
+
+const char* TimestampCache::dateTime (void)
+{
+    refresh();
+
+    return dateTimeBuffer;
+}
+
+const char* TimestampCache::fileDateTime (void)
+{
+    refresh();
+
+    return fileDateTimeBuffer;
+}
+
+void TimestampCache::refresh (void)
+{
+    time_t now = time(NULL);
+
+    if (now == cachedSecond)
+    {
+        return;
+    }
+
+    cachedSecond = now;
+
+    // Fill in the time the same way bz_getUTCtime() does so the broken down time and the strings are for the same second
+    struct tm utc;
+    gmtime_r(&now, &utc);
+
+    cachedTime.year            = utc.tm_year + 1900;
+    cachedTime.month           = utc.tm_mon + 1;
+    cachedTime.day             = utc.tm_mday;
+    cachedTime.dayofweek       = utc.tm_wday;
+    cachedTime.hour            = utc.tm_hour;
+    cachedTime.minute          = utc.tm_min;
+    cachedTime.second          = utc.tm_sec;
+    cachedTime.daylightSavings = (utc.tm_isdst != 0);
+
+    snprintf(dateTimeBuffer, sizeof(dateTimeBuffer), "%02d-%02d-%02d %02d:%02d:%02d",
+             cachedTime.year, cachedTime.month, cachedTime.day, cachedTime.hour, cachedTime.minute, cachedTime.second);
+
+    snprintf(fileDateTimeBuffer, sizeof(fileDateTimeBuffer), "%d%02d%02d-%02d%02d%02d",
+             cachedTime.year, cachedTime.month, cachedTime.day, cachedTime.hour, cachedTime.minute, cachedTime.second);
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __TIMESTAMP_CACHE_H__
+#define __TIMESTAMP_CACHE_H__
+
+#include <ctime>
+
+#include "bzfsAPI.h"
+
+// Wall-clock timestamps only change once a second, but we ask for them on every join and part. The current UTC time
+// is formatted once when the second changes and every caller until the next second is handed the same buffers. The
+// pointers stay valid for as long as the cache does, but their contents change so copy them if they need to be kept.
+//
+// This is only meant to be used from the server's thread.
+class TimestampCache
+{
+    public:
+        TimestampCache ();
+
+        const bz_Time& utcTime       (void);
+        const char*    dateTime      (void);
+        const char*    fileDateTime  (void);
+
+    private:
+        void refresh (void);
+
+        time_t  cachedSecond;
+        bz_Time cachedTime;
+
+        char    dateTimeBuffer[32],       // year-month-day hour:minute:second
+                fileDateTimeBuffer[32];   // yearmonthday-hourminutesecond, which is safe to use in file names
+};
+
+#endif
\ No newline at end of file
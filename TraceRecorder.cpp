@@ -0,0 +1,139 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+
+#include "JsonWriter.h"
+#include "TraceRecorder.h"
+
+TraceRecorder::Scope::Scope (TraceRecorder &_recorder, const char* _name) :
+    recorder(_recorder),
+    name(_name),
+    startTime(-1)
+{
+    if (recorder.active && name)
+    {
+        startTime = recorder.now();
+    }
+}
+
+TraceRecorder::Scope::~Scope ()
+{
+    if (startTime >= 0)
+    {
+        recorder.record(name, startTime, recorder.now());
+    }
+}
+
+TraceRecorder::TraceRecorder () :
+    active(false),
+    droppedSpans(0)
+{}
+
+// Throw away the last trace and start recording a new one
+void TraceRecorder::start (void)
+{
+    spans.clear();
+    spans.reserve(TRACE_BUFFER_SIZE);
+
+    origin       = std::chrono::steady_clock::now();
+    droppedSpans = 0;
+    active       = true;
+}
+
+// Stop recording and write the trace to a file; the buffer is given back once it has been written
+bool TraceRecorder::stop (std::string path)
+{
+    active = false;
+
+    JsonWriter json(spans.size() * 96 + 64);
+
+    json.beginObject()
+        .set("displayTimeUnit", "ms")
+        .key("traceEvents").beginArray();
+
+    for (const Span &span : spans)
+    {
+        json.beginObject()
+            .set("name", span.name)
+            .set("cat",  "LeagueOverseer")
+            .set("ph",   "X")
+            .set("ts",   span.startTime)
+            .set("dur",  span.duration)
+            .set("pid",  1)
+            .set("tid",  1)
+            .endObject();
+    }
+
+    json.endArray().endObject();
+
+    std::vector<Span>().swap(spans);
+
+    FILE *file = fopen(path.c_str(), "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = (fwrite(json.c_str(), 1, json.size(), file) == json.size());
+
+    return (fclose(file) == 0) && written;
+}
+
+bool TraceRecorder::recording (void) const
+{
+    return active;
+}
+
+int TraceRecorder::spanCount (void) const
+{
+    return (int)spans.size();
+}
+
+int TraceRecorder::dropped (void) const
+{
+    return droppedSpans;
+}
+
+long long TraceRecorder::now (void) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void TraceRecorder::record (const char* name, long long startTime, long long endTime)
+{
+    // The trace may have been stopped while this scope was open
+    if (!active)
+    {
+        return;
+    }
+
+    if (spans.size() >= TRACE_BUFFER_SIZE)
+    {
+        droppedSpans++;
+        return;
+    }
+
+    Span span;
+    span.name      = name;
+    span.startTime = startTime;
+    span.duration  = endTime - startTime;
+
+    spans.push_back(span);
+}
\ No newline at end of file
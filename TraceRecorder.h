@@ -0,0 +1,75 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __TRACE_RECORDER_H__
+#define __TRACE_RECORDER_H__
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define TRACE_BUFFER_SIZE 65536
+
+// Records how long the plug-in spends in the parts of its work that are wrapped in a TraceRecorder::Scope and writes
+// them as a Chrome trace that can be loaded into chrome://tracing or Perfetto. The spans are kept in a buffer that's
+// allocated when the trace starts, so recording one costs two reads of the clock and a store; when the buffer is
+// full, spans are counted and dropped. While no trace is being recorded, a scope only checks a boolean.
+//
+// Span names are kept by pointer so they have to be string literals or outlive the trace.
+class TraceRecorder
+{
+    public:
+        class Scope
+        {
+            public:
+                Scope (TraceRecorder &recorder, const char* name);
+                ~Scope ();
+
+            private:
+                TraceRecorder &recorder;
+                const char*    name;
+                long long      startTime;
+        };
+
+        TraceRecorder ();
+
+        void start     (void);
+        bool stop      (std::string path);
+        bool recording (void) const;
+        int  spanCount (void) const;
+        int  dropped   (void) const;
+
+    private:
+        struct Span
+        {
+            const char* name;
+            long long   startTime,  // Microseconds since the trace started
+                        duration;
+        };
+
+        std::vector<Span> spans;
+        std::chrono::steady_clock::time_point origin;
+
+        bool active;
+        int  droppedSpans;
+
+        long long now    (void) const;
+        void      record (const char* name, long long startTime, long long endTime);
+};
+
+#endif
\ No newline at end of file
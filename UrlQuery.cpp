@@ -16,13 +16,61 @@ League Overseer
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
+
 #include "UrlQuery.h"
 
-UrlQuery::UrlQuery() {}
+// Stands in for the handler of a single request so its answer can be timed from the moment that request was sent;
+// the callbacks don't say which job they belong to and jobs don't finish in the order they were sent. It passes the
+// answer on and then deletes itself, since nothing else knows it exists.
+class TimedUrlJob : public bz_BaseURLHandler
+{
+    public:
+        TimedUrlJob(bz_BaseURLHandler* handler, Metrics* metrics) :
+            _handler(handler),
+            _metrics(metrics),
+            _submitted(std::chrono::steady_clock::now())
+        {}
+
+        virtual void URLDone(const char* URL, const void* data, unsigned int size, bool complete)
+        {
+            _metrics->urlJobFinished(URL_JOB_DONE, std::chrono::steady_clock::now() - _submitted);
+            _handler->URLDone(URL, data, size, complete);
+            delete this;
+        }
+
+        virtual void URLTimeout(const char* URL, int errorCode)
+        {
+            _metrics->urlJobFinished(URL_JOB_TIMEOUT, std::chrono::steady_clock::now() - _submitted);
+            _handler->URLTimeout(URL, errorCode);
+            delete this;
+        }
+
+        virtual void URLError(const char* URL, int errorCode, const char* errorString)
+        {
+            _metrics->urlJobFinished(URL_JOB_ERROR, std::chrono::steady_clock::now() - _submitted);
+            _handler->URLError(URL, errorCode, errorString);
+            delete this;
+        }
+
+    private:
+        bz_BaseURLHandler* _handler;
+        Metrics*           _metrics;
 
-UrlQuery::UrlQuery(bz_BaseURLHandler* handler, const char* url)
+        std::chrono::steady_clock::time_point _submitted;
+};
+
+UrlQuery::UrlQuery() :
+    _handler(NULL),
+    _relay(NULL),
+    _metrics(NULL)
+{}
+
+UrlQuery::UrlQuery(bz_BaseURLHandler* handler, const char* url, ReportRelay* relay, Metrics* metrics)
 {
     _handler = handler;
+    _relay = relay;
+    _metrics = metrics;
     _URL = url;
     _query = queryDefault;
 }
@@ -47,15 +95,45 @@ UrlQuery& UrlQuery::set(std::string field, const char* value)
     return query(field, value);
 }
 
+// Throw away the fields that have been set so far
+UrlQuery& UrlQuery::reset()
+{
+    _query = queryDefault;
+    return *this;
+}
+
+// Change who is told how the request went; NULL sends it without anyone being told
+UrlQuery& UrlQuery::setHandler(bz_BaseURLHandler* handler)
+{
+    _handler = handler;
+    return *this;
+}
+
 void UrlQuery::submit()
 {
-    bz_addURLJob(_URL, _handler, _query.c_str()); // Send off the URL job
-    _query = queryDefault;                        // Reset the query so this object can be reused
+    bz_BaseURLHandler* handler = _handler;
+
+    // Nobody listens to a request sent without a handler (the plug-in may be gone by the time it's answered), so there
+    // is nothing to time it for
+    if (_metrics && _handler)
+    {
+        handler = new TimedUrlJob(_handler, _metrics);
+    }
+
+    // Let the relay daemon send the request if there is one; otherwise BZFS sends it like it always has
+    if (!_relay || !_relay->submit(_URL.c_str(), _query, handler))
+    {
+        bz_addURLJob(_URL.c_str(), handler, _query.c_str()); // Send off the URL job
+    }
+
+    reset(); // Reset the query so this object can be reused
 }
 
 UrlQuery UrlQuery::operator=(const UrlQuery& rhs)
 {
     _handler = rhs._handler;
+    _relay = rhs._relay;
+    _metrics = rhs._metrics;
     _URL = rhs._URL;
     _query = rhs._query;
 
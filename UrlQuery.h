@@ -24,18 +24,23 @@ League Overseer
 #include "bzfsAPI.h"
 
 #include "LeagueOverseer-Version.h"
+#include "Metrics.h"
+#include "ReportRelay.h"
 
 class UrlQuery
 {
     public:
         UrlQuery();
-        UrlQuery(bz_BaseURLHandler* handler, const char* url);
+        UrlQuery(bz_BaseURLHandler* handler, const char* url, ReportRelay* relay = NULL, Metrics* metrics = NULL);
 
         UrlQuery& set(std::string field, int value);
         UrlQuery& set(std::string field, bz_ApiString value);
         UrlQuery& set(std::string field, std::string value);
         UrlQuery& set(std::string field, const char* value);
 
+        UrlQuery& reset();
+        UrlQuery& setHandler(bz_BaseURLHandler* handler);
+
         void submit();
 
         UrlQuery operator=(const UrlQuery& rhs);
@@ -44,7 +49,9 @@ class UrlQuery
         std::string queryDefault = "apiVersion=" + std::to_string(API_VERSION);
 
         bz_BaseURLHandler* _handler;
-        const char*        _URL;
+        ReportRelay*       _relay;
+        Metrics*           _metrics;
+        std::string        _URL;
         std::string        _query;
 
         UrlQuery& query(std::string field, const char* value);
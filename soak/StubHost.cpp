@@ -0,0 +1,900 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <ctime>
+
+#include "plugin_utils.h"
+
+#include "StubHost.h"
+
+StubHost stubHost;
+
+static std::string urlDecode (const std::string &value)
+{
+    std::string decoded;
+
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        if (value[i] == '%' && i + 2 < value.size())
+        {
+            decoded += (char)strtol(value.substr(i + 1, 2).c_str(), NULL, 16);
+            i += 2;
+        }
+        else
+        {
+            decoded += (value[i] == '+') ? ' ' : value[i];
+        }
+    }
+
+    return decoded;
+}
+
+StubHost::StubHost () :
+    verbose(false),
+    plugin(NULL),
+    muteListVersion(0),
+    now(1000.0),
+    timeLimit(0),
+    countdown(COUNTDOWN_NONE),
+    paused(false),
+    countdownEnds(0),
+    matchEnds(0),
+    pausedAt(0),
+    records(0),
+    lists(0)
+{
+    for (bool &event : registered)
+    {
+        event = false;
+    }
+}
+
+void StubHost::load (bz_Plugin* _plugin, const char* config)
+{
+    plugin = _plugin;
+    pluginName = plugin->Name();
+
+    plugin->Init(config);
+}
+
+void StubHost::unload (void)
+{
+    if (plugin)
+    {
+        plugin->Cleanup();
+        plugin = NULL;
+    }
+}
+
+// A player connects: BZFS picks their team, asks for their motto and then announces them
+int StubHost::join (std::string callsign, std::string bzID, bz_eTeamType team, bool verified, std::vector<std::string> groups)
+{
+    int playerID = 0;
+
+    while (players.count(playerID))
+    {
+        playerID++;
+    }
+
+    if (playerID >= 256)
+    {
+        return -1;
+    }
+
+    Player &player = players[playerID];
+
+    player.callsign  = callsign;
+    player.bzID      = bzID;
+    player.ipAddress = "127.0.0." + std::to_string(playerID + 1);
+    player.team      = eNoTeam;
+    player.verified  = verified;
+    player.groups    = groups;
+
+    bz_GetAutoTeamEventData_V1 autoTeamData;
+    autoTeamData.playerID = playerID;
+    autoTeamData.callsign = callsign;
+    autoTeamData.team     = team;
+    fire(autoTeamData);
+
+    player.team = autoTeamData.team;
+
+    bz_BasePlayerRecord record;
+    fillRecord(playerID, record);
+
+    bz_GetPlayerMottoData_V2 mottoData;
+    mottoData.record = &record;
+    fire(mottoData);
+
+    bz_PlayerJoinPartEventData_V1 joinData(bz_ePlayerJoinEvent);
+    joinData.playerID = playerID;
+    joinData.record   = &record;
+    fire(joinData);
+
+    return playerID;
+}
+
+void StubHost::part (int playerID)
+{
+    if (!players.count(playerID))
+    {
+        return;
+    }
+
+    bz_BasePlayerRecord record;
+    fillRecord(playerID, record);
+
+    bz_PlayerJoinPartEventData_V1 partData(bz_ePlayerPartEvent);
+    partData.playerID = playerID;
+    partData.record   = &record;
+    partData.reason   = "left";
+    fire(partData);
+
+    players.erase(playerID);
+}
+
+void StubHost::grant (int playerID, std::string perm)
+{
+    if (players.count(playerID))
+    {
+        players[playerID].perms.insert(perm);
+    }
+}
+
+int StubHost::playerCount (void) const
+{
+    return (int)players.size();
+}
+
+// BZFS tells every plug-in about the command first, then hands it to whoever registered it
+void StubHost::slashCommand (int playerID, std::string text)
+{
+    bz_SlashCommandEventData_V1 slashCommandData;
+    slashCommandData.from    = playerID;
+    slashCommandData.message = text;
+    fire(slashCommandData);
+
+    size_t      space   = text.find(' ');
+    std::string command = text.substr(1, space - 1),
+                message = (space == std::string::npos) ? "" : text.substr(space + 1);
+
+    std::transform(command.begin(), command.end(), command.begin(), ::tolower);
+
+    std::map<std::string, bz_CustomSlashCommandHandler*>::iterator handler = commands.find(command);
+
+    if (handler != commands.end())
+    {
+        bz_APIStringList params;
+        std::vector<std::string> tokens = tokenize(message, " ", 0, true);
+
+        for (std::vector<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+        {
+            params.push_back(*it);
+        }
+
+        handler->second->SlashCommand(playerID, command, message, &params);
+    }
+}
+
+void StubHost::chat (int playerID, int to, bz_eTeamType team, std::string message)
+{
+    bz_ChatEventData_V1 chatData;
+    chatData.from    = playerID;
+    chatData.to      = to;
+    chatData.team    = team;
+    chatData.message = message;
+    fire(chatData);
+}
+
+void StubHost::capture (int playerID, bz_eTeamType teamCapped)
+{
+    bz_CTFCaptureEventData_V1 captureData;
+    captureData.teamCapped    = teamCapped;
+    captureData.teamCapping   = bz_getPlayerTeam(playerID);
+    captureData.playerCapping = playerID;
+    fire(captureData);
+}
+
+void StubHost::kill (int victimID, int killerID)
+{
+    bz_PlayerDieEventData_V1 dieData;
+    dieData.playerID   = victimID;
+    dieData.team       = bz_getPlayerTeam(victimID);
+    dieData.killerID   = killerID;
+    dieData.killerTeam = bz_getPlayerTeam(killerID);
+    dieData.shotID     = 1;
+    fire(dieData);
+}
+
+void StubHost::spawn (int playerID)
+{
+    bz_AllowSpawnData_V1 allowSpawnData;
+    allowSpawnData.playerID = playerID;
+    allowSpawnData.team     = bz_getPlayerTeam(playerID);
+    fire(allowSpawnData);
+}
+
+void StubHost::grabFlag (int playerID, int flagID)
+{
+    bz_AllowFlagGrabData_V1 allowFlagGrabData;
+    allowFlagGrabData.playerID = playerID;
+    allowFlagGrabData.flagID   = flagID;
+    allowFlagGrabData.flagType = (flagID == 0) ? "R*" : "B*";
+    fire(allowFlagGrabData);
+}
+
+void StubHost::advance (double seconds, double tickInterval)
+{
+    double end = now + seconds;
+
+    while (now < end)
+    {
+        now = std::min(now + tickInterval, end);
+
+        if (countdown == COUNTDOWN_STARTING && now >= countdownEnds)
+        {
+            countdown = COUNTDOWN_ACTIVE;
+            matchEnds = now + timeLimit;
+
+            bz_GameStartEndEventData_V1 gameStartData(bz_eGameStartEvent);
+            gameStartData.duration = timeLimit;
+            fire(gameStartData);
+        }
+        else if (countdown == COUNTDOWN_ACTIVE && !paused && now >= matchEnds)
+        {
+            bz_gameOver(BZ_SERVER);
+        }
+
+        bz_TickEventData_V1 tickData;
+        fire(tickData);
+    }
+}
+
+void StubHost::setLeagueTeam (std::string bzID, std::string teamName)
+{
+    leagueTeams[bzID] = teamName;
+}
+
+void StubHost::mute (std::string bzID, bool muted)
+{
+    if (muted)
+    {
+        leagueMuted.insert(bzID);
+    }
+    else
+    {
+        leagueMuted.erase(bzID);
+    }
+
+    muteListVersion++;
+}
+
+// Answer every URL job that has been sent, including the ones sent while answering
+int StubHost::answerUrlJobs (void)
+{
+    int answered = 0;
+
+    while (!urlJobs.empty())
+    {
+        UrlJob job = urlJobs.front();
+        urlJobs.pop_front();
+
+        std::string response = leagueSiteResponse(job.postData);
+
+        if (job.handler)
+        {
+            job.handler->URLDone(job.url.c_str(), response.c_str(), (unsigned int)response.size(), true);
+        }
+
+        answered++;
+    }
+
+    return answered;
+}
+
+int StubHost::pendingUrlJobs (void) const
+{
+    return (int)urlJobs.size();
+}
+
+int StubHost::liveRecords (void) const
+{
+    return records;
+}
+
+int StubHost::liveLists (void) const
+{
+    return lists;
+}
+
+int StubHost::registeredEvents (void) const
+{
+    return (int)std::count(registered, registered + bz_eLastEvent, true);
+}
+
+int StubHost::registeredCommands (void) const
+{
+    return (int)commands.size();
+}
+
+void StubHost::fire (bz_EventData &eventData)
+{
+    eventData.eventTime = now;
+
+    if (plugin && registered[eventData.eventType])
+    {
+        plugin->Event(&eventData);
+    }
+}
+
+void StubHost::fillRecord (int playerID, bz_BasePlayerRecord &record) const
+{
+    const Player &player = players.at(playerID);
+
+    record.playerID   = playerID;
+    record.callsign   = player.callsign;
+    record.ipAddress  = player.ipAddress;
+    record.team       = player.team;
+    record.bzID       = player.bzID;
+    record.verified   = player.verified;
+    record.globalUser = player.verified;
+    record.canSpawn   = (player.team != eObservers);
+
+    for (std::vector<std::string>::const_iterator it = player.groups.begin(); it != player.groups.end(); ++it)
+    {
+        record.groups.push_back(*it);
+    }
+}
+
+// The answers the league site gives to the queries the plug-in sends
+std::string StubHost::leagueSiteResponse (const std::string &postData)
+{
+    std::map<std::string, std::string> fields;
+    std::vector<std::string> pairs = tokenize(postData, "&", 0, false);
+
+    for (std::vector<std::string>::const_iterator it = pairs.begin(); it != pairs.end(); ++it)
+    {
+        size_t equals = it->find('=');
+
+        if (equals != std::string::npos)
+        {
+            fields[it->substr(0, equals)] = urlDecode(it->substr(equals + 1));
+        }
+    }
+
+    std::string query = fields["query"];
+
+    if (query == "teamName")
+    {
+        return "{\"bzid\": \"" + fields["bzid"] + "\", \"team\": \"" + leagueTeams[fields["bzid"]] + "\"}";
+    }
+    else if (query == "teamNameDump")
+    {
+        std::map<std::string, std::string> members;
+
+        for (std::map<std::string, std::string>::const_iterator it = leagueTeams.begin(); it != leagueTeams.end(); ++it)
+        {
+            if (!it->second.empty())
+            {
+                members[it->second] += (members[it->second].empty() ? "" : ",") + it->first;
+            }
+        }
+
+        std::string response = "{\"teamDump\": [";
+
+        for (std::map<std::string, std::string>::const_iterator it = members.begin(); it != members.end(); ++it)
+        {
+            response += std::string((it == members.begin()) ? "" : ", ") + "{\"team\": \"" + it->first + "\", \"members\": \"" + it->second + "\"}";
+        }
+
+        return response + "]}";
+    }
+    else if (query == "muteList")
+    {
+        std::string response = "{\"muteList\": {\"version\": " + std::to_string(muteListVersion) + ", \"full\": true, \"muted\": [";
+
+        for (std::set<std::string>::const_iterator it = leagueMuted.begin(); it != leagueMuted.end(); ++it)
+        {
+            response += std::string((it == leagueMuted.begin()) ? "" : ", ") + "\"" + *it + "\"";
+        }
+
+        return response + "], \"unmuted\": []}}";
+    }
+
+    return "Match reported";
+}
+
+///
+/// The API functions the plug-in calls
+///
+
+bz_Plugin::~bz_Plugin ()
+{}
+
+bool bz_Plugin::Register (bz_eEventType eventType)
+{
+    stubHost.registered[eventType] = true;
+    return true;
+}
+
+bool bz_Plugin::Remove (bz_eEventType eventType)
+{
+    bool wasRegistered = stubHost.registered[eventType];
+
+    stubHost.registered[eventType] = false;
+    return wasRegistered;
+}
+
+void bz_Plugin::Flush (void)
+{
+    for (bool &event : stubHost.registered)
+    {
+        event = false;
+    }
+}
+
+bz_APIIntList* bz_newIntList (void)
+{
+    stubHost.lists++;
+    return new bz_APIIntList();
+}
+
+void bz_deleteIntList (bz_APIIntList* l)
+{
+    if (l)
+    {
+        stubHost.lists--;
+        delete l;
+    }
+}
+
+bz_APIIntList* bz_getPlayerIndexList (void)
+{
+    bz_APIIntList* playerList = bz_newIntList();
+
+    for (std::map<int, StubHost::Player>::const_iterator it = stubHost.players.begin(); it != stubHost.players.end(); ++it)
+    {
+        playerList->push_back(it->first);
+    }
+
+    return playerList;
+}
+
+bz_BasePlayerRecord* bz_getPlayerByIndex (int index)
+{
+    if (!stubHost.players.count(index))
+    {
+        return NULL;
+    }
+
+    bz_BasePlayerRecord* playerRecord = new bz_BasePlayerRecord();
+    stubHost.fillRecord(index, *playerRecord);
+    stubHost.records++;
+
+    return playerRecord;
+}
+
+bool bz_freePlayerRecord (bz_BasePlayerRecord* playerRecord)
+{
+    if (!playerRecord)
+    {
+        return false;
+    }
+
+    stubHost.records--;
+    delete playerRecord;
+
+    return true;
+}
+
+bz_eTeamType bz_getPlayerTeam (int playerID)
+{
+    std::map<int, StubHost::Player>::const_iterator player = stubHost.players.find(playerID);
+
+    return (player != stubHost.players.end()) ? player->second.team : eNoTeam;
+}
+
+const char* bz_getPlayerCallsign (int playerID)
+{
+    std::map<int, StubHost::Player>::const_iterator player = stubHost.players.find(playerID);
+
+    return (player != stubHost.players.end()) ? player->second.callsign.c_str() : NULL;
+}
+
+bool bz_grantPerm (int playerID, const char* perm)
+{
+    if (!stubHost.players.count(playerID))
+    {
+        return false;
+    }
+
+    stubHost.players[playerID].perms.insert(perm);
+    return true;
+}
+
+bool bz_revokePerm (int playerID, const char* perm)
+{
+    if (!stubHost.players.count(playerID))
+    {
+        return false;
+    }
+
+    stubHost.players[playerID].perms.erase(perm);
+    return true;
+}
+
+bool bz_hasPerm (int playerID, const char* perm)
+{
+    std::map<int, StubHost::Player>::const_iterator player = stubHost.players.find(playerID);
+
+    return (player != stubHost.players.end()) && player->second.perms.count(perm);
+}
+
+bool bz_registerCustomSlashCommand (const char* command, bz_CustomSlashCommandHandler* handler)
+{
+    stubHost.commands[command] = handler;
+    return true;
+}
+
+bool bz_removeCustomSlashCommand (const char* command)
+{
+    return stubHost.commands.erase(command) > 0;
+}
+
+bool bz_addURLJob (const char* URL, bz_BaseURLHandler* handler, const char* postData)
+{
+    StubHost::UrlJob job;
+    job.url      = URL;
+    job.postData = (postData) ? postData : "";
+    job.handler  = handler;
+
+    stubHost.urlJobs.push_back(job);
+    return true;
+}
+
+int bz_callPluginGenericCallback (const char* plugin, const char* name, void* data)
+{
+    if (!stubHost.plugin || stubHost.pluginName != plugin)
+    {
+        return 0;
+    }
+
+    return stubHost.plugin->GeneralCallback(name, data);
+}
+
+int bz_getLoadedPlugins (bz_APIStringList* list)
+{
+    if (stubHost.plugin)
+    {
+        list->push_back(stubHost.pluginName);
+    }
+
+    return (int)list->size();
+}
+
+bool bz_setclipFieldString (const char* field, const char* data)
+{
+    stubHost.clipFields[field] = data;
+    return true;
+}
+
+const char* bz_getclipFieldString (const char* field)
+{
+    std::map<std::string, std::string>::const_iterator clipField = stubHost.clipFields.find(field);
+
+    return (clipField != stubHost.clipFields.end()) ? clipField->second.c_str() : NULL;
+}
+
+bool bz_clipFieldExists (const char* field)
+{
+    return stubHost.clipFields.count(field) > 0;
+}
+
+void bz_debugMessage (int level, const char* message)
+{
+    if (stubHost.verbose)
+    {
+        fprintf(stderr, "%d: %s\n", level, message);
+    }
+}
+
+void bz_debugMessagef (int level, const char* fmt, ...)
+{
+    char buffer[4096];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    bz_debugMessage(level, buffer);
+}
+
+// Nobody is listening to the chat, so messages are only formatted to make sure the arguments are good
+bool bz_sendTextMessage (int /*from*/, int /*to*/, const char* message)
+{
+    return message != NULL;
+}
+
+bool bz_sendTextMessage (int /*from*/, bz_eTeamType /*to*/, const char* message)
+{
+    return message != NULL;
+}
+
+bool bz_sendTextMessagef (int from, int to, const char* fmt, ...)
+{
+    char buffer[2048];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    return bz_sendTextMessage(from, to, buffer);
+}
+
+bool bz_sendTextMessagef (int from, bz_eTeamType to, const char* fmt, ...)
+{
+    char buffer[2048];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    return bz_sendTextMessage(from, to, buffer);
+}
+
+// Like BZFS, the returned string is only good until the next call
+const char* bz_urlEncode (const char* value)
+{
+    static std::string encoded;
+    static const char hex[] = "0123456789ABCDEF";
+
+    encoded.clear();
+
+    for (const char* c = value; c && *c; c++)
+    {
+        if (isalnum((unsigned char)*c) || strchr("-_.~", *c))
+        {
+            encoded += *c;
+        }
+        else
+        {
+            encoded += '%';
+            encoded += hex[(unsigned char)*c >> 4];
+            encoded += hex[(unsigned char)*c & 15];
+        }
+    }
+
+    return encoded.c_str();
+}
+
+const char* bz_toupper (const char* value)
+{
+    static std::string upper;
+
+    upper = (value) ? value : "";
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+
+    return upper.c_str();
+}
+
+double bz_getCurrentTime (void)
+{
+    return stubHost.now;
+}
+
+void bz_getUTCtime (bz_Time* ts)
+{
+    time_t now = time(NULL);
+    struct tm utc;
+
+    gmtime_r(&now, &utc);
+
+    ts->year            = utc.tm_year + 1900;
+    ts->month           = utc.tm_mon + 1;
+    ts->day             = utc.tm_mday;
+    ts->hour            = utc.tm_hour;
+    ts->minute          = utc.tm_min;
+    ts->second          = utc.tm_sec;
+    ts->dayofweek       = utc.tm_wday;
+    ts->daylightSavings = false;
+}
+
+bool bz_BZDBItemExists (const char* variable)
+{
+    return stubHost.bzdb.count(variable) > 0;
+}
+
+bool bz_setBZDBInt (const char* variable, int val, int /*perms*/, bool /*persistent*/)
+{
+    stubHost.bzdb[variable] = std::to_string(val);
+
+    bz_BZDBChangeData_V1 bzdbData(variable, stubHost.bzdb[variable]);
+    stubHost.fire(bzdbData);
+
+    return true;
+}
+
+int bz_getBZDBInt (const char* variable)
+{
+    std::map<std::string, std::string>::const_iterator item = stubHost.bzdb.find(variable);
+
+    return (item != stubHost.bzdb.end()) ? atoi(item->second.c_str()) : 0;
+}
+
+bz_ApiString bz_getPublicAddr (void)
+{
+    return bz_ApiString("localhost");
+}
+
+int bz_getPublicPort (void)
+{
+    return 5154;
+}
+
+int bz_getTeamCount (bz_eTeamType team)
+{
+    int count = 0;
+
+    for (std::map<int, StubHost::Player>::const_iterator it = stubHost.players.begin(); it != stubHost.players.end(); ++it)
+    {
+        count += (it->second.team == team);
+    }
+
+    return count;
+}
+
+// The stub's map is a two team CTF map with red and blue flags
+int bz_getTeamPlayerLimit (bz_eTeamType team)
+{
+    return (team == eRedTeam || team == eBlueTeam || team == eObservers) ? 10 : 0;
+}
+
+unsigned int bz_getNumFlags (void)
+{
+    return 2;
+}
+
+bz_ApiString bz_getFlagName (int flag)
+{
+    return bz_ApiString((flag == 0) ? "R*" : (flag == 1) ? "B*" : "");
+}
+
+bool bz_isAutoTeamEnabled (void)
+{
+    return true;
+}
+
+bool bz_isTimeManualStart (void)
+{
+    return true;
+}
+
+bool bz_pollActive (void)
+{
+    return false;
+}
+
+float bz_getTimeLimit (void)
+{
+    return stubHost.timeLimit;
+}
+
+void bz_setTimeLimit (float timeLimit)
+{
+    stubHost.timeLimit = timeLimit;
+}
+
+bool bz_isCountDownActive (void)
+{
+    return stubHost.countdown == StubHost::COUNTDOWN_ACTIVE;
+}
+
+bool bz_isCountDownInProgress (void)
+{
+    return stubHost.countdown == StubHost::COUNTDOWN_STARTING;
+}
+
+bool bz_isCountDownPaused (void)
+{
+    return stubHost.paused;
+}
+
+void bz_startCountdown (int delay, float limit, const char* /*byWho*/)
+{
+    if (stubHost.countdown != StubHost::COUNTDOWN_NONE)
+    {
+        return;
+    }
+
+    stubHost.countdown     = StubHost::COUNTDOWN_STARTING;
+    stubHost.countdownEnds = stubHost.now + delay;
+    stubHost.timeLimit     = limit;
+}
+
+void bz_pauseCountdown (const char* pausedBy)
+{
+    if (stubHost.countdown != StubHost::COUNTDOWN_ACTIVE || stubHost.paused)
+    {
+        return;
+    }
+
+    stubHost.paused   = true;
+    stubHost.pausedAt = stubHost.now;
+
+    bz_GamePauseResumeEventData_V1 gamePauseData(bz_eGamePauseEvent);
+    gamePauseData.actionBy = pausedBy;
+    stubHost.fire(gamePauseData);
+}
+
+void bz_resumeCountdown (const char* resumedBy)
+{
+    if (!stubHost.paused)
+    {
+        return;
+    }
+
+    stubHost.paused     = false;
+    stubHost.matchEnds += stubHost.now - stubHost.pausedAt;
+
+    bz_GamePauseResumeEventData_V1 gameResumeData(bz_eGameResumeEvent);
+    gameResumeData.actionBy = resumedBy;
+    stubHost.fire(gameResumeData);
+}
+
+void bz_cancelCountdown (const char* /*canceledBy*/)
+{
+    if (stubHost.countdown == StubHost::COUNTDOWN_STARTING)
+    {
+        stubHost.countdown = StubHost::COUNTDOWN_NONE;
+    }
+}
+
+void bz_gameOver (int playerID, bz_eTeamType /*team*/)
+{
+    if (stubHost.countdown == StubHost::COUNTDOWN_NONE)
+    {
+        return;
+    }
+
+    stubHost.countdown = StubHost::COUNTDOWN_NONE;
+    stubHost.paused    = false;
+
+    bz_GameStartEndEventData_V1 gameEndData(bz_eGameEndEvent);
+    gameEndData.duration = stubHost.timeLimit;
+    gameEndData.playerID = playerID;
+    gameEndData.gameOver = true;
+    stubHost.fire(gameEndData);
+}
+
+// Recording needs a real server; the plug-in only needs to be told it worked
+bool bz_startRecBuf (void)
+{
+    return true;
+}
+
+bool bz_stopRecBuf (void)
+{
+    return true;
+}
+
+bool bz_saveRecBuf (const char* /*filename*/, int /*seconds*/)
+{
+    return true;
+}
\ No newline at end of file
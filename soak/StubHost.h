@@ -0,0 +1,167 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __STUB_HOST_H__
+#define __STUB_HOST_H__
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bzfsAPI.h"
+
+// Stands in for BZFS so the plug-in can be loaded, sent events and answered by a fake league site without a server or
+// a network. Time only moves when advance() is called, so a match that takes twenty minutes on a real server is over
+// in a few milliseconds. The player records and lists handed to the plug-in are counted until they're freed, which
+// is how the soak test catches a plug-in that forgets to give one back.
+class StubHost
+{
+    public:
+        StubHost ();
+
+        void load   (bz_Plugin* plugin, const char* config);
+        void unload (void);
+
+        // Players
+        int  join   (std::string callsign, std::string bzID, bz_eTeamType team, bool verified, std::vector<std::string> groups);
+        void part   (int playerID);
+        void grant  (int playerID, std::string perm);
+        int  playerCount (void) const;
+
+        // Things players do
+        void slashCommand (int playerID, std::string text);
+        void chat    (int playerID, int to, bz_eTeamType team, std::string message);
+        void capture (int playerID, bz_eTeamType teamCapped);
+        void kill    (int victimID, int killerID);
+        void spawn   (int playerID);
+        void grabFlag (int playerID, int flagID);
+
+        // Move the server clock forward, ticking the plug-in and running the countdown as it goes
+        void advance (double seconds, double tickInterval = 0.5);
+
+        // The fake league site
+        void setLeagueTeam (std::string bzID, std::string teamName);
+        void mute          (std::string bzID, bool muted);
+        int  answerUrlJobs (void);
+        int  pendingUrlJobs (void) const;
+
+        // Leak accounting for what the plug-in borrows from us
+        int  liveRecords (void) const;
+        int  liveLists (void) const;
+        int  registeredEvents (void) const;
+        int  registeredCommands (void) const;
+
+        bool verbose;
+
+    private:
+        struct Player
+        {
+            std::string              callsign,
+                                     bzID,
+                                     ipAddress;
+            bz_eTeamType             team;
+            bool                     verified;
+            std::vector<std::string> groups;
+            std::set<std::string>    perms;
+        };
+
+        struct UrlJob
+        {
+            std::string        url,
+                               postData;
+            bz_BaseURLHandler* handler;
+        };
+
+        enum CountdownState
+        {
+            COUNTDOWN_NONE,
+            COUNTDOWN_STARTING,
+            COUNTDOWN_ACTIVE
+        };
+
+        void        fire (bz_EventData &eventData);
+        void        fillRecord (int playerID, bz_BasePlayerRecord &record) const;
+        std::string leagueSiteResponse (const std::string &postData);
+
+        bz_Plugin*  plugin;
+        std::string pluginName;
+        bool        registered[bz_eLastEvent];
+
+        std::map<int, Player> players;
+        std::map<std::string, bz_CustomSlashCommandHandler*> commands;
+        std::map<std::string, std::string> clipFields;
+        std::map<std::string, std::string> bzdb;
+        std::deque<UrlJob> urlJobs;
+
+        std::map<std::string, std::string> leagueTeams;
+        std::set<std::string>              leagueMuted;
+        int                                muteListVersion;
+
+        double         now;
+        float          timeLimit;
+        CountdownState countdown;
+        bool           paused;
+        double         countdownEnds,
+                       matchEnds,
+                       pausedAt;
+
+        int records,
+            lists;
+
+        friend bz_APIIntList*       bz_newIntList (void);
+        friend void                 bz_deleteIntList (bz_APIIntList* l);
+        friend bz_APIIntList*       bz_getPlayerIndexList (void);
+        friend bz_BasePlayerRecord* bz_getPlayerByIndex (int index);
+        friend bool                 bz_freePlayerRecord (bz_BasePlayerRecord* playerRecord);
+        friend bz_eTeamType         bz_getPlayerTeam (int playerID);
+        friend const char*          bz_getPlayerCallsign (int playerID);
+        friend bool                 bz_grantPerm (int playerID, const char* perm);
+        friend bool                 bz_revokePerm (int playerID, const char* perm);
+        friend bool                 bz_hasPerm (int playerID, const char* perm);
+        friend bool                 bz_registerCustomSlashCommand (const char* command, bz_CustomSlashCommandHandler* handler);
+        friend bool                 bz_removeCustomSlashCommand (const char* command);
+        friend bool                 bz_addURLJob (const char* URL, bz_BaseURLHandler* handler, const char* postData);
+        friend int                  bz_callPluginGenericCallback (const char* plugin, const char* name, void* data);
+        friend int                  bz_getLoadedPlugins (bz_APIStringList* list);
+        friend bool                 bz_setclipFieldString (const char* field, const char* data);
+        friend const char*          bz_getclipFieldString (const char* field);
+        friend bool                 bz_clipFieldExists (const char* field);
+        friend void                 bz_debugMessage (int level, const char* message);
+        friend double               bz_getCurrentTime (void);
+        friend bool                 bz_BZDBItemExists (const char* variable);
+        friend bool                 bz_setBZDBInt (const char* variable, int val, int perms, bool persistent);
+        friend int                  bz_getBZDBInt (const char* variable);
+        friend int                  bz_getTeamCount (bz_eTeamType team);
+        friend float                bz_getTimeLimit (void);
+        friend void                 bz_setTimeLimit (float timeLimit);
+        friend bool                 bz_isCountDownActive (void);
+        friend bool                 bz_isCountDownInProgress (void);
+        friend bool                 bz_isCountDownPaused (void);
+        friend void                 bz_startCountdown (int delay, float limit, const char* byWho);
+        friend void                 bz_pauseCountdown (const char* pausedBy);
+        friend void                 bz_resumeCountdown (const char* resumedBy);
+        friend void                 bz_cancelCountdown (const char* canceledBy);
+        friend void                 bz_gameOver (int playerID, bz_eTeamType team);
+        friend class bz_Plugin;
+};
+
+extern StubHost stubHost;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,480 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The part of the BZFS 2.4 plug-in API that League Overseer uses, declared the same way so the plug-in's sources
+// build unchanged against the stub host in StubHost.cpp instead of a real server. Only the soak test is built with
+// this header; the plug-in itself is always built against the real one in the BZFlag source tree.
+
+#ifndef _BZFS_API_H_
+#define _BZFS_API_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <strings.h>
+#include <vector>
+
+#define BZ_SERVER   -2
+#define BZ_ALLUSERS -1
+#define BZ_NULLUSER -3
+
+typedef enum
+{
+    eNoTeam = -1,
+    eRogueTeam = 0,
+    eRedTeam,
+    eGreenTeam,
+    eBlueTeam,
+    ePurpleTeam,
+    eRabbitTeam,
+    eHunterTeam,
+    eObservers,
+    eAdministrators
+} bz_eTeamType;
+
+typedef enum
+{
+    bz_eNullEvent = 0,
+    bz_eCaptureEvent,
+    bz_ePlayerDieEvent,
+    bz_ePlayerSpawnEvent,
+    bz_eZoneEntryEvent,
+    bz_eZoneExitEvent,
+    bz_ePlayerJoinEvent,
+    bz_ePlayerPartEvent,
+    bz_eRawChatMessageEvent,
+    bz_eFilteredChatMessageEvent,
+    bz_eUnknownSlashCommand,
+    bz_eGetPlayerSpawnPosEvent,
+    bz_eGetAutoTeamEvent,
+    bz_eAllowPlayer,
+    bz_eTickEvent,
+    bz_eGetWorldEvent,
+    bz_eGetPlayerInfoEvent,
+    bz_eAllowSpawn,
+    bz_eListServerUpdateEvent,
+    bz_eBanEvent,
+    bz_eHostBanModifyEvent,
+    bz_eKickEvent,
+    bz_eKillEvent,
+    bz_ePlayerPausedEvent,
+    bz_eMessageFilteredEvent,
+    bz_eGameStartEvent,
+    bz_eGameEndEvent,
+    bz_eSlashCommandEvent,
+    bz_ePlayerAuthEvent,
+    bz_eServerMsgEvent,
+    bz_eShotFiredEvent,
+    bz_ePlayerUpdateEvent,
+    bz_eNetDataReceiveEvent,
+    bz_eNetDataSendEvent,
+    bz_eLoggingEvent,
+    bz_eShotEndedEvent,
+    bz_eFlagTransferredEvent,
+    bz_eFlagGrabbedEvent,
+    bz_eFlagDroppedEvent,
+    bz_eAllowCTFCaptureEvent,
+    bz_eMsgDebugEvent,
+    bz_eNewNonPlayerConnection,
+    bz_ePollStartEvent,
+    bz_ePollVoteEvent,
+    bz_ePollEndEvent,
+    bz_eAllowPollEvent,
+    bz_eAllowFlagGrab,
+    bz_eBZDBChange,
+    bz_eGetPlayerMotto,
+    bz_eGamePauseEvent,
+    bz_eGameResumeEvent,
+    bz_eLastEvent
+} bz_eEventType;
+
+///
+/// Strings and lists
+///
+
+class bz_ApiString
+{
+    public:
+        bz_ApiString () {}
+        bz_ApiString (const char* c) : data(c ? c : "") {}
+        bz_ApiString (const std::string &s) : data(s) {}
+
+        bz_ApiString& operator= (const char* c)        { data = (c ? c : ""); return *this; }
+        bz_ApiString& operator= (const std::string &s) { data = s; return *this; }
+
+        bool operator== (const char* c) const          { return data == (c ? c : ""); }
+        bool operator== (const std::string &s) const   { return data == s; }
+        bool operator== (const bz_ApiString &s) const  { return data == s.data; }
+        bool operator!= (const char* c) const          { return !(*this == c); }
+        bool operator!= (const std::string &s) const   { return !(*this == s); }
+        bool operator!= (const bz_ApiString &s) const  { return !(*this == s); }
+
+        const char*  c_str (void) const { return data.c_str(); }
+        unsigned int size  (void) const { return (unsigned int)data.size(); }
+        bool         empty (void) const { return data.empty(); }
+
+    private:
+        std::string data;
+};
+
+class bz_APIIntList
+{
+    public:
+        void         push_back (int value)             { data.push_back(value); }
+        int          get       (unsigned int i) const  { return data[i]; }
+        int          operator[](unsigned int i) const  { return data[i]; }
+        unsigned int size      (void) const            { return (unsigned int)data.size(); }
+        void         clear     (void)                  { data.clear(); }
+
+    private:
+        std::vector<int> data;
+};
+
+class bz_APIStringList
+{
+    public:
+        void                push_back (const bz_ApiString &value) { data.push_back(value); }
+        void                push_back (const std::string &value)  { data.push_back(bz_ApiString(value)); }
+        const bz_ApiString& get       (unsigned int i) const      { return data[i]; }
+        const bz_ApiString& operator[](unsigned int i) const      { return data[i]; }
+        unsigned int        size      (void) const                { return (unsigned int)data.size(); }
+        void                clear     (void)                      { data.clear(); }
+
+    private:
+        std::vector<bz_ApiString> data;
+};
+
+bz_APIIntList* bz_newIntList (void);
+void           bz_deleteIntList (bz_APIIntList* l);
+
+///
+/// Players
+///
+
+class bz_BasePlayerRecord
+{
+    public:
+        bz_BasePlayerRecord () :
+            version(1), playerID(-1), team(eNoTeam), spawned(false), verified(false), globalUser(false), admin(false), op(false), canSpawn(false)
+        {}
+        virtual ~bz_BasePlayerRecord () {}
+
+        int              version;
+        int              playerID;
+        bz_ApiString     callsign;
+        bz_eTeamType     team;
+        bz_ApiString     ipAddress;
+        bool             spawned,
+                         verified,
+                         globalUser;
+        bz_ApiString     bzID;
+        bool             admin,
+                         op,
+                         canSpawn;
+        bz_APIStringList groups;
+};
+
+bz_APIIntList*       bz_getPlayerIndexList (void);
+bz_BasePlayerRecord* bz_getPlayerByIndex (int index);
+bool                 bz_freePlayerRecord (bz_BasePlayerRecord* playerRecord);
+bz_eTeamType         bz_getPlayerTeam (int playerID);
+const char*          bz_getPlayerCallsign (int playerID);
+
+bool bz_grantPerm (int playerID, const char* perm);
+bool bz_revokePerm (int playerID, const char* perm);
+bool bz_hasPerm (int playerID, const char* perm);
+
+///
+/// Events
+///
+
+class bz_EventData
+{
+    public:
+        bz_EventData (bz_eEventType type = bz_eNullEvent) : version(1), eventType(type), eventTime(0) {}
+        virtual ~bz_EventData () {}
+
+        int           version;
+        bz_eEventType eventType;
+        double        eventTime;
+};
+
+class bz_AllowFlagGrabData_V1 : public bz_EventData
+{
+    public:
+        bz_AllowFlagGrabData_V1 () : bz_EventData(bz_eAllowFlagGrab), playerID(-1), flagID(-1), flagType(NULL), allow(true) {}
+
+        int         playerID,
+                    flagID;
+        const char* flagType;
+        bool        allow;
+};
+
+class bz_AllowSpawnData_V1 : public bz_EventData
+{
+    public:
+        bz_AllowSpawnData_V1 () : bz_EventData(bz_eAllowSpawn), playerID(-1), team(eNoTeam), handled(false), allow(true) {}
+
+        int          playerID;
+        bz_eTeamType team;
+        bool         handled,
+                     allow;
+};
+
+class bz_BZDBChangeData_V1 : public bz_EventData
+{
+    public:
+        bz_BZDBChangeData_V1 (const std::string &_key, const std::string &_value) : bz_EventData(bz_eBZDBChange), key(_key), value(_value) {}
+
+        bz_ApiString key,
+                     value;
+};
+
+class bz_CTFCaptureEventData_V1 : public bz_EventData
+{
+    public:
+        bz_CTFCaptureEventData_V1 () : bz_EventData(bz_eCaptureEvent), teamCapped(eNoTeam), teamCapping(eNoTeam), playerCapping(-1), rot(0)
+        {
+            pos[0] = pos[1] = pos[2] = 0;
+        }
+
+        bz_eTeamType teamCapped,
+                     teamCapping;
+        int          playerCapping;
+        float        pos[3],
+                     rot;
+};
+
+class bz_ChatEventData_V1 : public bz_EventData
+{
+    public:
+        bz_ChatEventData_V1 () : bz_EventData(bz_eRawChatMessageEvent), from(BZ_SERVER), to(BZ_ALLUSERS), team(eNoTeam) {}
+
+        int          from,
+                     to;
+        bz_eTeamType team;
+        bz_ApiString message;
+};
+
+class bz_GamePauseResumeEventData_V1 : public bz_EventData
+{
+    public:
+        bz_GamePauseResumeEventData_V1 (bz_eEventType type) : bz_EventData(type), actionBy("SERVER") {}
+
+        bz_ApiString actionBy;
+};
+
+class bz_GameStartEndEventData_V1 : public bz_EventData
+{
+    public:
+        bz_GameStartEndEventData_V1 (bz_eEventType type) : bz_EventData(type), duration(0), playerID(BZ_SERVER), gameOver(false) {}
+
+        double duration;
+        int    playerID;
+        bool   gameOver;
+};
+
+class bz_GetAutoTeamEventData_V1 : public bz_EventData
+{
+    public:
+        bz_GetAutoTeamEventData_V1 () : bz_EventData(bz_eGetAutoTeamEvent), playerID(-1), team(eNoTeam), handled(false) {}
+
+        int          playerID;
+        bz_ApiString callsign;
+        bz_eTeamType team;
+        bool         handled;
+};
+
+class bz_GetPlayerMottoData_V2 : public bz_EventData
+{
+    public:
+        bz_GetPlayerMottoData_V2 () : bz_EventData(bz_eGetPlayerMotto), record(NULL) { version = 2; }
+
+        bz_ApiString         motto;
+        bz_BasePlayerRecord* record;
+};
+
+class bz_PlayerDieEventData_V1 : public bz_EventData
+{
+    public:
+        bz_PlayerDieEventData_V1 () : bz_EventData(bz_ePlayerDieEvent), playerID(-1), team(eNoTeam), killerID(-1), killerTeam(eNoTeam), shotID(-1) {}
+
+        int          playerID;
+        bz_eTeamType team;
+        int          killerID;
+        bz_eTeamType killerTeam;
+        bz_ApiString flagKilledWith;
+        int          shotID;
+};
+
+class bz_PlayerJoinPartEventData_V1 : public bz_EventData
+{
+    public:
+        bz_PlayerJoinPartEventData_V1 (bz_eEventType type) : bz_EventData(type), playerID(-1), record(NULL) {}
+
+        int                  playerID;
+        bz_BasePlayerRecord* record;
+        bz_ApiString         reason;
+};
+
+class bz_SlashCommandEventData_V1 : public bz_EventData
+{
+    public:
+        bz_SlashCommandEventData_V1 () : bz_EventData(bz_eSlashCommandEvent), from(-1) {}
+
+        int          from;
+        bz_ApiString message;
+};
+
+class bz_TickEventData_V1 : public bz_EventData
+{
+    public:
+        bz_TickEventData_V1 () : bz_EventData(bz_eTickEvent) {}
+};
+
+///
+/// Plug-ins and handlers
+///
+
+class bz_Plugin
+{
+    public:
+        bz_Plugin () : MaxWaitTime(-1), Unloadable(true) {}
+        virtual ~bz_Plugin ();
+
+        virtual const char* Name (void) = 0;
+        virtual void        Init (const char* config) = 0;
+        virtual void        Cleanup (void) { Flush(); }
+        virtual void        Event (bz_EventData* /*eventData*/) {}
+        virtual int         GeneralCallback (const char* /*name*/, void* /*data*/) { return 0; }
+
+        float MaxWaitTime;
+        bool  Unloadable;
+
+    protected:
+        bool Register (bz_eEventType eventType);
+        bool Remove (bz_eEventType eventType);
+        void Flush (void);
+};
+
+#define BZ_PLUGIN(n) \
+    extern "C" bz_Plugin* bz_GetPlugin (void) { return new n; } \
+    extern "C" void bz_FreePlugin (bz_Plugin* plugin) { delete plugin; }
+
+class bz_CustomSlashCommandHandler
+{
+    public:
+        virtual ~bz_CustomSlashCommandHandler () {}
+        virtual bool SlashCommand (int playerID, bz_ApiString command, bz_ApiString message, bz_APIStringList* params) = 0;
+};
+
+bool bz_registerCustomSlashCommand (const char* command, bz_CustomSlashCommandHandler* handler);
+bool bz_removeCustomSlashCommand (const char* command);
+
+class bz_BaseURLHandler
+{
+    public:
+        bz_BaseURLHandler () : version(1) {}
+        virtual ~bz_BaseURLHandler () {}
+
+        virtual void URLDone (const char* URL, const void* data, unsigned int size, bool complete) = 0;
+        virtual void URLTimeout (const char* /*URL*/, int /*errorCode*/) {}
+        virtual void URLError (const char* /*URL*/, int /*errorCode*/, const char* /*errorString*/) {}
+
+    protected:
+        int version;
+};
+
+bool bz_addURLJob (const char* URL, bz_BaseURLHandler* handler = NULL, const char* postData = NULL);
+
+int  bz_callPluginGenericCallback (const char* plugin, const char* name, void* data);
+int  bz_getLoadedPlugins (bz_APIStringList* list);
+
+bool        bz_setclipFieldString (const char* field, const char* data);
+const char* bz_getclipFieldString (const char* field);
+bool        bz_clipFieldExists (const char* field);
+
+///
+/// Messages and utilities
+///
+
+void bz_debugMessage (int level, const char* message);
+void bz_debugMessagef (int level, const char* fmt, ...);
+
+bool bz_sendTextMessage (int from, int to, const char* message);
+bool bz_sendTextMessage (int from, bz_eTeamType to, const char* message);
+bool bz_sendTextMessagef (int from, int to, const char* fmt, ...);
+bool bz_sendTextMessagef (int from, bz_eTeamType to, const char* fmt, ...);
+
+const char* bz_urlEncode (const char* value);
+const char* bz_toupper (const char* value);
+
+///
+/// Server state
+///
+
+typedef struct
+{
+    int  year,
+         month,
+         day,
+         hour,
+         minute,
+         second,
+         dayofweek;
+    bool daylightSavings;
+} bz_Time;
+
+double       bz_getCurrentTime (void);
+void         bz_getUTCtime (bz_Time* ts);
+
+bool         bz_BZDBItemExists (const char* variable);
+bool         bz_setBZDBInt (const char* variable, int val, int perms = 0, bool persistent = false);
+int          bz_getBZDBInt (const char* variable);
+
+bz_ApiString bz_getPublicAddr (void);
+int          bz_getPublicPort (void);
+
+int          bz_getTeamCount (bz_eTeamType team);
+int          bz_getTeamPlayerLimit (bz_eTeamType team);
+
+unsigned int bz_getNumFlags (void);
+bz_ApiString bz_getFlagName (int flag);
+
+bool         bz_isAutoTeamEnabled (void);
+bool         bz_isTimeManualStart (void);
+bool         bz_pollActive (void);
+
+float        bz_getTimeLimit (void);
+void         bz_setTimeLimit (float timeLimit);
+
+bool         bz_isCountDownActive (void);
+bool         bz_isCountDownInProgress (void);
+bool         bz_isCountDownPaused (void);
+void         bz_startCountdown (int delay, float limit, const char* byWho);
+void         bz_pauseCountdown (const char* pausedBy);
+void         bz_resumeCountdown (const char* resumedBy);
+void         bz_cancelCountdown (const char* canceledBy);
+void         bz_gameOver (int playerID, bz_eTeamType team = eNoTeam);
+
+bool         bz_startRecBuf (void);
+bool         bz_stopRecBuf (void);
+bool         bz_saveRecBuf (const char* filename, int seconds = 0);
+
+#endif
\ No newline at end of file
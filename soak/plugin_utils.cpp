@@ -0,0 +1,137 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "plugin_utils.h"
+
+static std::string trim (const std::string &value)
+{
+    size_t first = value.find_first_not_of(" \t\r\n"),
+           last  = value.find_last_not_of(" \t\r\n");
+
+    return (first == std::string::npos) ? "" : value.substr(first, last - first + 1);
+}
+
+static std::string lower (std::string value)
+{
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    return value;
+}
+
+// Split a string on any of the delimiters. Quoted tokens may hold delimiters and once there are maxTokens - 1
+// tokens, the rest of the string is the last one.
+std::vector<std::string> tokenize (const std::string &in, const std::string &delims, const int maxTokens, const bool useQuotes)
+{
+    std::vector<std::string> tokens;
+    size_t position = in.find_first_not_of(delims);
+
+    while (position != std::string::npos)
+    {
+        if (maxTokens > 0 && (int)tokens.size() == maxTokens - 1)
+        {
+            tokens.push_back(in.substr(position));
+            break;
+        }
+
+        size_t end;
+
+        if (useQuotes && in[position] == '"')
+        {
+            end = in.find('"', position + 1);
+            tokens.push_back(in.substr(position + 1, (end == std::string::npos) ? std::string::npos : end - position - 1));
+            end = (end == std::string::npos) ? end : end + 1;
+        }
+        else
+        {
+            end = in.find_first_of(delims, position);
+            tokens.push_back(in.substr(position, (end == std::string::npos) ? std::string::npos : end - position));
+        }
+
+        position = (end == std::string::npos) ? end : in.find_first_not_of(delims, end);
+    }
+
+    return tokens;
+}
+
+PluginConfig::PluginConfig () :
+    errors(0)
+{}
+
+PluginConfig::PluginConfig (const std::string &filename) :
+    errors(0)
+{
+    std::ifstream file(filename.c_str());
+    std::string line, section;
+
+    if (!file)
+    {
+        errors++;
+        return;
+    }
+
+    while (std::getline(file, line))
+    {
+        line = trim(line);
+
+        if (line.empty() || line[0] == '#' || line[0] == ';')
+        {
+            continue;
+        }
+
+        if (line[0] == '[')
+        {
+            size_t close = line.find(']');
+
+            if (close == std::string::npos)
+            {
+                errors++;
+                continue;
+            }
+
+            section = lower(trim(line.substr(1, close - 1)));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+
+        if (equals == std::string::npos || section.empty())
+        {
+            errors++;
+            continue;
+        }
+
+        sections[section][lower(trim(line.substr(0, equals)))] = trim(line.substr(equals + 1));
+    }
+}
+
+std::string PluginConfig::item (const std::string &section, const std::string &key)
+{
+    std::map<std::string, std::map<std::string, std::string>>::const_iterator items = sections.find(lower(section));
+
+    if (items == sections.end())
+    {
+        return "";
+    }
+
+    std::map<std::string, std::string>::const_iterator value = items->second.find(lower(key));
+
+    return (value != items->second.end()) ? value->second : "";
+}
\ No newline at end of file
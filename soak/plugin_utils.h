@@ -0,0 +1,47 @@
+/*
+League Overseer
+    Copyright (C) 2013-2015 Vladimir Jimenez & Ned Anderson
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The part of BZFlag's plugin_utils that League Overseer uses, for the soak test's stub host
+
+#ifndef _PLUGIN_UTILS_H_
+#define _PLUGIN_UTILS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bzfsAPI.h"
+
+std::vector<std::string> tokenize (const std::string &in, const std::string &delims, const int maxTokens, const bool useQuotes);
+
+// Reads an INI style file of [sections] holding "key = value" lines; sections and keys are case insensitive
+class PluginConfig
+{
+    public:
+        PluginConfig ();
+        PluginConfig (const std::string &filename);
+
+        std::string item (const std::string &section, const std::string &key);
+
+        unsigned int errors;
+
+    private:
+        std::map<std::string, std::map<std::string, std::string>> sections;
+};
+
+#endif
\ No newline at end of file